@@ -140,7 +140,7 @@ void AIModule::think(BattleAction *action)
 	_melee = (_unit->getMeleeWeapon() != 0);
 	_rifle = false;
 	_blaster = false;
-	_reachable = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits());
+	_reachable = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits(), &_reachableCosts);
 	_wasHitBy.clear();
 
 	if (_unit->getCharging() && _unit->getCharging()->isOut())
@@ -187,18 +187,18 @@ void AIModule::think(BattleAction *action)
 				if (rule->getWaypoints() != 0 || (action->weapon->getAmmoItem() && action->weapon->getAmmoItem()->getRules()->getWaypoints() != 0))
 				{
 					_blaster = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
+					selectReachableWithAttack(_unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
 				}
 				else
 				{
 					_rifle = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_SNAPSHOT, action->weapon));
+					selectReachableWithAttack(_unit->getActionTUs(BA_SNAPSHOT, action->weapon));
 				}
 			}
 			else if (rule->getBattleType() == BT_MELEE)
 			{
 				_melee = true;
-				_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, action->weapon));
+				selectReachableWithAttack(_unit->getActionTUs(BA_HIT, action->weapon));
 			}
 		}
 		else
@@ -2016,6 +2016,27 @@ BattleActionType AIModule::getReserveMode()
 	return _reserve;
 }
 
+/**
+ * Picks the tiles we can reach and still have enough TUs left to attack from.
+ * These are the tiles of _reachable which are cheap enough, so there is no need
+ * to run the pathfinding again with a lower TU limit.
+ * @param attackTUs The TUs needed for the attack.
+ */
+void AIModule::selectReachableWithAttack(int attackTUs)
+{
+	const int tuMax = _unit->getTimeUnits() - attackTUs;
+	const int start = _save->getTileIndex(_unit->getPosition());
+	_reachableWithAttack.clear();
+	for (size_t i = 0; i < _reachable.size(); ++i)
+	{
+		// findReachable() always returns the start tile, even with no TUs to spare
+		if (_reachable[i] == start || _reachableCosts[i] <= tuMax)
+		{
+			_reachableWithAttack.push_back(_reachable[i]);
+		}
+	}
+}
+
 /**
  * We have a dichotomy on our hands: we have a ranged weapon and melee capability.
  * let's make a determination on which one we'll be using this round.
@@ -2069,7 +2090,7 @@ void AIModule::selectMeleeOrRanged()
 		if (RNG::percent(meleeOdds))
 		{
 			_rifle = false;
-			_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, meleeWeapon));
+			selectReachableWithAttack(_unit->getActionTUs(BA_HIT, meleeWeapon));
 			return;
 		}
 	}
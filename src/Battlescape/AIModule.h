@@ -50,7 +50,7 @@ private:
 	bool _traceAI, _didPsi;
 	int _AIMode, _intelligence, _closestDist;
 	Node *_fromNode, *_toNode;
-	std::vector<int> _reachable, _reachableWithAttack, _wasHitBy;
+	std::vector<int> _reachable, _reachableCosts, _reachableWithAttack, _wasHitBy;
 	BattleActionType _reserve;
 	UnitFaction _targetFaction;
 public:
@@ -113,6 +113,8 @@ public:
 	bool validTarget(BattleUnit* unit, bool assessDanger, bool includeCivs) const;
 	/// Checks the alien's TU reservation setting.
 	BattleActionType getReserveMode();
+	/// Picks the reachable tiles that leave enough TUs for an attack.
+	void selectReachableWithAttack(int attackTUs);
 	/// Assuming we have both a ranged and a melee weapon, we have to select one.
 	void selectMeleeOrRanged();
 	/// Gets the current targetted unit.
@@ -89,7 +89,7 @@ AbortMissionState::AbortMissionState(SavedBattleGame *battleGame, BattlescapeSta
 		exit = false;
 		for (int i = 0; i < _battleGame->getMapSizeXYZ(); ++i)
 		{
-			Tile *tile = _battleGame->getTiles()[i];
+			Tile *tile = _battleGame->getTile(i);
 			if (tile && tile->getMapData(O_FLOOR) && tile->getMapData(O_FLOOR)->getSpecialType() == END_POINT)
 			{
 				exit = true;
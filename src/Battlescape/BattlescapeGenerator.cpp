@@ -998,9 +998,9 @@ BattleUnit *BattlescapeGenerator::addXCOMUnit(BattleUnit *unit)
 		{
 			for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 			{
-				if (canPlaceXCOMUnit(_save->getTiles()[i]))
+				if (canPlaceXCOMUnit(_save->getTile(i)))
 				{
-					if (_save->setUnitPosition(unit, _save->getTiles()[i]->getPosition()))
+					if (_save->setUnitPosition(unit, _save->getTile(i)->getPosition()))
 					{
 						_save->getUnits()->push_back(unit);
 						unit->setSpecialWeapon(_save, _game->getMod());
@@ -1785,12 +1785,12 @@ void BattlescapeGenerator::fuelPowerSources()
 {
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		if (_save->getTiles()[i]->getMapData(O_OBJECT)
-			&& _save->getTiles()[i]->getMapData(O_OBJECT)->getSpecialType() == UFO_POWER_SOURCE)
+		if (_save->getTile(i)->getMapData(O_OBJECT)
+			&& _save->getTile(i)->getMapData(O_OBJECT)->getSpecialType() == UFO_POWER_SOURCE)
 		{
 			BattleItem *alienFuel = new BattleItem(_game->getMod()->getItem(_game->getMod()->getAlienFuelName(), true), _save->getCurrentItemId());
 			_save->getItems()->push_back(alienFuel);
-			_save->getTiles()[i]->addItem(alienFuel, _game->getMod()->getInventory("STR_GROUND", true));
+			_save->getTile(i)->addItem(alienFuel, _game->getMod()->getInventory("STR_GROUND", true));
 		}
 	}
 }
@@ -1803,13 +1803,13 @@ void BattlescapeGenerator::explodePowerSources()
 {
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		if (_save->getTiles()[i]->getMapData(O_OBJECT)
-			&& _save->getTiles()[i]->getMapData(O_OBJECT)->getSpecialType() == UFO_POWER_SOURCE && RNG::percent(75))
+		if (_save->getTile(i)->getMapData(O_OBJECT)
+			&& _save->getTile(i)->getMapData(O_OBJECT)->getSpecialType() == UFO_POWER_SOURCE && RNG::percent(75))
 		{
 			Position pos;
-			pos.x = _save->getTiles()[i]->getPosition().x*16;
-			pos.y = _save->getTiles()[i]->getPosition().y*16;
-			pos.z = (_save->getTiles()[i]->getPosition().z*24) +12;
+			pos.x = _save->getTile(i)->getPosition().x*16;
+			pos.y = _save->getTile(i)->getPosition().y*16;
+			pos.z = (_save->getTile(i)->getPosition().z*24) +12;
 			_save->getTileEngine()->explode(pos, 180+RNG::generate(0,70), DT_HE, 10);
 		}
 	}
@@ -1950,7 +1950,7 @@ void BattlescapeGenerator::runInventory(Craft *craft)
 	_save->initMap(_mapsize_x, _mapsize_y, _mapsize_z);
 	MapDataSet *set = new MapDataSet("dummy");
 	MapData *data = new MapData(set);
-	_craftInventoryTile = _save->getTiles()[0];
+	_craftInventoryTile = _save->getTile(0);
 
 	// ok now generate the battleitems for inventory
 	setCraft(craft);
@@ -3006,7 +3006,7 @@ void BattlescapeGenerator::setupObjectives(AlienDeployment *ruleDeploy)
 			for (int j = O_FLOOR; j <= O_OBJECT; ++j)
 			{
 				TilePart tp = (TilePart)j;
-				if (_save->getTiles()[i]->getMapData(tp) && _save->getTiles()[i]->getMapData(tp)->getSpecialType() == targetType)
+				if (_save->getTile(i)->getMapData(tp) && _save->getTile(i)->getMapData(tp)->getSpecialType() == targetType)
 				{
 					actualCount++;
 				}
@@ -68,6 +68,7 @@ private:
 	PathPreview _previewSetting;
 	Text *_txtAccuracy;
 	SurfaceSet *_projectileSet;
+	SurfaceSet *_cursorSet, *_floorObSet, *_smokeSet, *_pathfindingSet, *_explosionSet, *_hitSet;
 
 	void drawUnit(Surface *surface, Tile *unitTile, Tile *currTile, Position tileScreenPosition, int shade, int obstacleShade, bool topLayer);
 	void drawTerrain(Surface *surface);
@@ -19,7 +19,6 @@
 #include <list>
 #include <algorithm>
 #include "Pathfinding.h"
-#include "PathfindingOpenSet.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Mod/Armor.h"
@@ -49,6 +48,7 @@ Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPr
 		_save->getTileCoords(i, &p.x, &p.y, &p.z);
 		_nodes.push_back(PathfindingNode(p));
 	}
+	_wallCache.resize(_size * MOVEMENT_TYPES, 0);
 }
 
 /**
@@ -198,7 +198,8 @@ bool Pathfinding::aStarPath(Position startPosition, Position endPosition, Battle
 	// start position is the first one in our "open" list
 	PathfindingNode *start = getNode(startPosition);
 	start->connect(0, 0, 0, endPosition);
-	PathfindingOpenSet openList;
+	PathfindingOpenSet &openList = _openSet;
+	openList.clear();
 	openList.push(start);
 	bool missile = (target && maxTUCost == 10000);
 	// if the open list is empty, we've reached the end
@@ -689,6 +690,37 @@ bool Pathfinding::isBlocked(Tile *tile, const int part, BattleUnit *missileTarge
  * @return True if the movement is blocked.
  */
 bool Pathfinding::isBlocked(Tile *startTile, Tile * /* endTile */, const int direction, BattleUnit *missileTarget)
+{
+	// walls don't care about units, so without a missile the answer only depends on the terrain
+	if (missileTarget != 0 || direction < 0 || direction >= DIR_UP)
+	{
+		return isWallBlocked(startTile, direction, missileTarget);
+	}
+	Uint16 &cached = _wallCache[_save->getTileIndex(startTile->getPosition()) * MOVEMENT_TYPES + _movementType];
+	const Uint16 known = 1 << direction;
+	if (cached & known)
+	{
+		return (cached & (known << 8)) != 0;
+	}
+	bool blocked = isWallBlocked(startTile, direction, 0);
+	// doors that are still moving change their cost without telling us
+	if (!isDoorAnimating(startTile))
+	{
+		cached |= known;
+		if (blocked)
+			cached |= known << 8;
+	}
+	return blocked;
+}
+
+/**
+ * Determines whether the walls between a tile and its neighbour in a direction block movement.
+ * @param startTile The tile to start from.
+ * @param direction The direction we are facing.
+ * @param missileTarget Target for a missile.
+ * @return True if the movement is blocked.
+ */
+bool Pathfinding::isWallBlocked(Tile *startTile, const int direction, BattleUnit *missileTarget)
 {
 
 	// check if the difference in height between start and destination is not too high
@@ -753,6 +785,49 @@ bool Pathfinding::isBlocked(Tile *startTile, Tile * /* endTile */, const int dir
 	return false;
 }
 
+/**
+ * Checks the walls a step from this tile can run into for ufo doors
+ * that have just started opening, as they stop costing TUs on the next frame.
+ * @param tile The tile to start from.
+ * @return True if any of them is opening.
+ */
+bool Pathfinding::isDoorAnimating(Tile *tile) const
+{
+	const Position pos = tile->getPosition();
+	for (int y = -1; y <= 1; ++y)
+	{
+		for (int x = -1; x <= 1; ++x)
+		{
+			Tile *t = _save->getTile(pos + Position(x, y, 0));
+			if (t && (t->isUfoDoorOpening(O_WESTWALL) || t->isUfoDoorOpening(O_NORTHWALL)))
+				return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Forgets the cached wall blockage of every tile whose steps look at the walls of this one.
+ * Must be called whenever a wall, door or big wall object on the tile changes.
+ * @param pos Position of the changed tile.
+ */
+void Pathfinding::invalidateTerrainCache(Position pos)
+{
+	// a diagonal step checks the walls of tiles one further along, hence the range of two
+	for (int y = pos.y - 2; y <= pos.y + 2; ++y)
+	{
+		for (int x = pos.x - 2; x <= pos.x + 2; ++x)
+		{
+			Position p(x, y, pos.z);
+			if (_save->getTile(p))
+			{
+				std::vector<Uint16>::iterator first = _wallCache.begin() + _save->getTileIndex(p) * MOVEMENT_TYPES;
+				std::fill(first, first + MOVEMENT_TYPES, 0);
+			}
+		}
+	}
+}
+
 /**
  * Determines whether a unit can fall down from this tile.
  * We can fall down here, if the tile does not exist, the tile has no floor
@@ -1151,9 +1226,10 @@ bool Pathfinding::bresenhamPath(Position origin, Position target, BattleUnit *ta
  * Uses Dijkstra's algorithm.
  * @param unit Pointer to the unit.
  * @param tuMax The maximum cost of the path to each tile.
+ * @param tuCosts If set, receives the cost of the path to each of the returned tiles.
  * @return An array of reachable tiles, sorted in ascending order of cost. The first tile is the start location.
  */
-std::vector<int> Pathfinding::findReachable(BattleUnit *unit, int tuMax)
+std::vector<int> Pathfinding::findReachable(BattleUnit *unit, int tuMax, std::vector<int> *tuCosts)
 {
 	Position start = unit->getPosition();
 	int energyMax = unit->getEnergy();
@@ -1163,7 +1239,8 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, int tuMax)
 	}
 	PathfindingNode *startNode = getNode(start);
 	startNode->connect(0, 0, 0);
-	PathfindingOpenSet unvisited;
+	PathfindingOpenSet &unvisited = _openSet;
+	unvisited.clear();
 	unvisited.push(startNode);
 	std::vector<PathfindingNode*> reachable;
 	while (!unvisited.empty())
@@ -1198,9 +1275,18 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, int tuMax)
 	std::sort(reachable.begin(), reachable.end(), MinNodeCosts());
 	std::vector<int> tiles;
 	tiles.reserve(reachable.size());
+	if (tuCosts)
+	{
+		tuCosts->clear();
+		tuCosts->reserve(reachable.size());
+	}
 	for (std::vector<PathfindingNode*>::const_iterator it = reachable.begin(); it != reachable.end(); ++it)
 	{
 		tiles.push_back(_save->getTileIndex((*it)->getPosition()));
+		if (tuCosts)
+		{
+			tuCosts->push_back((*it)->getTUCost(false));
+		}
 	}
 	return tiles;
 }
@@ -20,7 +20,9 @@
 #include <vector>
 #include "Position.h"
 #include "PathfindingNode.h"
+#include "PathfindingOpenSet.h"
 #include "../Mod/MapData.h"
+#include <SDL_types.h>
 
 namespace OpenXcom
 {
@@ -37,6 +39,7 @@ class Pathfinding
 private:
 	SavedBattleGame *_save;
 	std::vector<PathfindingNode> _nodes;
+	PathfindingOpenSet _openSet;
 	int _size;
 	BattleUnit *_unit;
 	bool _pathPreviewed;
@@ -44,10 +47,17 @@ private:
 	int _totalTUCost;
 	bool _modifierUsed;
 	MovementType _movementType;
+	static const int MOVEMENT_TYPES = MT_SINK + 1;
+	/// Per tile and movement type: low byte marks directions that are known, high byte those that are blocked.
+	std::vector<Uint16> _wallCache;
 	/// Gets the node at certain position.
 	PathfindingNode *getNode(Position pos);
 	/// Determines whether a tile blocks a certain movementType.
 	bool isBlocked(Tile *tile, const int part, BattleUnit *missileTarget, int bigWallExclusion = -1) const;
+	/// Determines whether walls block a step in the direction, without looking at the cache.
+	bool isWallBlocked(Tile *startTile, const int direction, BattleUnit *missileTarget);
+	/// Determines whether a ufo door around a tile has just started opening.
+	bool isDoorAnimating(Tile *tile) const;
 	/// Tries to find a straight line path between two positions.
 	bool bresenhamPath(Position origin, Position target, BattleUnit *missileTarget, bool sneak = false, int maxTUCost = 1000);
 	/// Tries to find a path between two positions.
@@ -97,8 +107,10 @@ public:
 	bool removePreview();
 	/// Sets _unit in order to abuse low-level pathfinding functions from outside the class.
 	void setUnit(BattleUnit *unit);
+	/// Forgets the cached wall blockage around a tile whose terrain changed.
+	void invalidateTerrainCache(Position pos);
 	/// Gets all reachable tiles, based on cost.
-	std::vector<int> findReachable(BattleUnit *unit, int tuMax);
+	std::vector<int> findReachable(BattleUnit *unit, int tuMax, std::vector<int> *tuCosts = 0);
 	/// Gets _totalTUCost; finds out whether we can hike somewhere in this turn or not.
 	int getTotalTUCost() const { return _totalTUCost; }
 	/// Gets the path preview setting.
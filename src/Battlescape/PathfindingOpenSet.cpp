@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <algorithm>
 #include "PathfindingOpenSet.h"
 #include "PathfindingNode.h"
 
@@ -24,66 +25,119 @@ namespace OpenXcom
 {
 
 /**
- * Cleans up all the entries still in set.
+ * Removes all entries from the set.
+ * The nodes are told they are no longer in it.
  */
-PathfindingOpenSet::~PathfindingOpenSet()
+void PathfindingOpenSet::clear()
 {
-	while (!_queue.empty())
+	for (std::vector<OpenSetEntry>::iterator i = _heap.begin(); i != _heap.end(); ++i)
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		i->_node->_openIndex = -1;
 	}
+	_heap.clear();
 }
 
 /**
- * Keeps removing all discarded entries that have come to the top of the queue.
+ * Gets the node with the lowest estimated path cost and removes it from the set.
+ * @return Pointer to the node which was at the top of the heap.
  */
-void PathfindingOpenSet::removeDiscarded()
+PathfindingNode *PathfindingOpenSet::pop()
 {
-	while (!_queue.empty() && !_queue.top()->_node)
+	assert(!empty());
+	PathfindingNode *nd = _heap.front()._node;
+	nd->_openIndex = -1;
+	OpenSetEntry last = _heap.back();
+	_heap.pop_back();
+	if (!_heap.empty())
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		place(0, last);
+		siftDown(0);
 	}
+	return nd;
 }
 
 /**
- * Gets the node with the least cost.
- * After this call, the node is no longer in the set. It is an error to call this when the set is empty.
- * @return A pointer to the node which had the least cost.
+ * Adds @a node to the set, or updates its place if it is already in it.
+ * @param node A pointer to the node to add.
  */
-PathfindingNode *PathfindingOpenSet::pop()
+void PathfindingOpenSet::push(PathfindingNode *node)
 {
-	assert(!empty());
-	OpenSetEntry *entry = _queue.top();
-	PathfindingNode *nd = entry->_node;
-	_queue.pop();
-	delete entry;
-	nd->_openentry = 0;
+	OpenSetEntry entry;
+	entry._node = node;
+	entry._cost = node->getTUCost(false) + node->getTUGuess();
+	if (node->_openIndex < 0)
+	{
+		_heap.push_back(entry);
+		node->_openIndex = _heap.size() - 1;
+		siftUp(node->_openIndex);
+	}
+	else
+	{
+		size_t index = node->_openIndex;
+		int oldCost = _heap[index]._cost;
+		_heap[index]._cost = entry._cost;
+		if (entry._cost < oldCost)
+			siftUp(index);
+		else
+			siftDown(index);
+	}
+}
 
-	// Discarded entries might be visible now.
-	removeDiscarded();
-	return nd;
+/**
+ * Moves the entry at @a index up until its parent is cheaper.
+ * @param index Heap position of the entry.
+ */
+void PathfindingOpenSet::siftUp(size_t index)
+{
+	OpenSetEntry entry = _heap[index];
+	while (index > 0)
+	{
+		size_t parent = (index - 1) / ARITY;
+		if (_heap[parent]._cost <= entry._cost)
+			break;
+		place(index, _heap[parent]);
+		index = parent;
+	}
+	place(index, entry);
 }
 
 /**
- * Places the node in the set.
- * If the node was already in the set, the previous entry is discarded.
- * It is the caller's responsibility to never re-add a node with a worse cost.
- * @param node A pointer to the node to add.
+ * Moves the entry at @a index down until all its children are more expensive.
+ * @param index Heap position of the entry.
  */
-void PathfindingOpenSet::push(PathfindingNode *node)
+void PathfindingOpenSet::siftDown(size_t index)
 {
-	OpenSetEntry *entry = new OpenSetEntry;
-	entry->_node = node;
-	entry->_cost = node->getTUCost(false) + node->getTUGuess();
-	if (node->_openentry)
-		node->_openentry->_node = 0;
-	node->_openentry = entry;
-	_queue.push(entry);
+	OpenSetEntry entry = _heap[index];
+	const size_t size = _heap.size();
+	for (;;)
+	{
+		size_t first = index * ARITY + 1;
+		if (first >= size)
+			break;
+		size_t best = first;
+		size_t last = std::min(first + ARITY, size);
+		for (size_t child = first + 1; child < last; ++child)
+		{
+			if (_heap[child]._cost < _heap[best]._cost)
+				best = child;
+		}
+		if (entry._cost <= _heap[best]._cost)
+			break;
+		place(index, _heap[best]);
+		index = best;
+	}
+	place(index, entry);
 }
 
+/**
+ * Stores @a entry at heap position @a index and lets its node know.
+ * @param index Heap position.
+ * @param entry The entry to store.
+ */
+void PathfindingOpenSet::place(size_t index, const OpenSetEntry &entry)
+{
+	_heap[index] = entry;
+	entry._node->_openIndex = index;
+}
 
 }
@@ -17,7 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <queue>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -31,43 +31,34 @@ struct OpenSetEntry
 };
 
 /**
- * Helper class to compare entries through pointers.
- */
-class EntryCompare
-{
-public:
-	/**
-	 * Compares entries @a *a and @a *b.
-	 * @param a Pointer to first entry.
-	 * @param b Pointer to second entry.
-	 * @return True if entry @a *b must come before @a *a.
-	 */
-	bool operator()(OpenSetEntry *a, OpenSetEntry *b) const
-	{
-		return b->_cost < a->_cost;
-	}
-};
-
-/**
- * A class that holds references to the nodes to be examined in pathfinding.
+ * A priority queue of nodes to check, ordered by estimated path cost.
+ * It is an indexed 4-ary heap: each node knows its place in the heap, so a node
+ * that gets a cheaper path is moved up in place instead of being added again.
+ * The storage is kept between searches, so a set that lives as long as its
+ * Pathfinding doesn't allocate once it has grown to the size of the map.
  */
 class PathfindingOpenSet
 {
 public:
-	/// Cleans up the set and frees allocated memory.
-	~PathfindingOpenSet();
+	/// Empties the set, keeping its storage.
+	void clear();
 	/// Gets the next node to check.
 	PathfindingNode *pop();
-	/// Adds a node to the set.
+	/// Adds a node to the set, or updates its cost.
 	void push(PathfindingNode *node);
 	/// Is the set empty?
-	bool empty() const { return _queue.empty(); }
+	bool empty() const { return _heap.empty(); }
 
 private:
-	std::priority_queue<OpenSetEntry*, std::vector<OpenSetEntry*>, EntryCompare> _queue;
+	static const size_t ARITY = 4;
+	std::vector<OpenSetEntry> _heap;
 
-	/// Removes reachable discarded entries.
-	void removeDiscarded();
+	/// Moves an entry towards the top of the heap.
+	void siftUp(size_t index);
+	/// Moves an entry towards the bottom of the heap.
+	void siftDown(size_t index);
+	/// Puts an entry at a heap position.
+	void place(size_t index, const OpenSetEntry &entry);
 };
 
 }
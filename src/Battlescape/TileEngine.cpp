@@ -19,6 +19,8 @@
 #include <assert.h>
 #include <climits>
 #include <set>
+#include <algorithm>
+#include <iterator>
 #include "TileEngine.h"
 #include <SDL.h>
 #include "AIModule.h"
@@ -46,15 +48,20 @@ namespace OpenXcom
 {
 
 const int TileEngine::heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12};
+const Sint16 TileEngine::BLOCKAGE_UNKNOWN;
 
 /**
  * Sets up a TileEngine.
  * @param save Pointer to SavedBattleGame object.
  * @param voxelData List of voxel data.
  */
-TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0)
+TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _lightMapSize(0), _lightDistanceSize(0), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0)
 {
 	_cacheTilePos = Position(-1,-1,-1);
+	for (int layer = 0; layer < LIGHTLAYERS; ++layer)
+	{
+		_lightLayerValid[layer] = false;
+	}
 }
 
 /**
@@ -74,8 +81,8 @@ void TileEngine::calculateSunShading()
 
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		_save->getTiles()[i]->resetLight(layer);
-		calculateSunShading(_save->getTiles()[i]);
+		_save->getTile(i)->resetLight(layer);
+		calculateSunShading(_save->getTile(i));
 	}
 }
 
@@ -117,43 +124,41 @@ void TileEngine::calculateTerrainLighting()
 	const int layer = 1; // Static lighting layer.
 	const int fireLightPower = 15; // amount of light a fire generates
 
-	// reset all light to 0 first
-	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
-	{
-		_save->getTiles()[i]->resetLight(layer);
-	}
+	std::vector<LightSource> lights;
 
 	// add lighting of terrain
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
+		Tile *tile = _save->getTile(i);
 		// only floors and objects can light up
-		if (_save->getTiles()[i]->getMapData(O_FLOOR)
-			&& _save->getTiles()[i]->getMapData(O_FLOOR)->getLightSource())
+		if (tile->getMapData(O_FLOOR)
+			&& tile->getMapData(O_FLOOR)->getLightSource())
 		{
-			addLight(_save->getTiles()[i]->getPosition(), _save->getTiles()[i]->getMapData(O_FLOOR)->getLightSource(), layer);
+			lights.push_back(LightSource(tile->getPosition(), tile->getMapData(O_FLOOR)->getLightSource()));
 		}
-		if (_save->getTiles()[i]->getMapData(O_OBJECT)
-			&& _save->getTiles()[i]->getMapData(O_OBJECT)->getLightSource())
+		if (tile->getMapData(O_OBJECT)
+			&& tile->getMapData(O_OBJECT)->getLightSource())
 		{
-			addLight(_save->getTiles()[i]->getPosition(), _save->getTiles()[i]->getMapData(O_OBJECT)->getLightSource(), layer);
+			lights.push_back(LightSource(tile->getPosition(), tile->getMapData(O_OBJECT)->getLightSource()));
 		}
 
 		// fires
-		if (_save->getTiles()[i]->getFire())
+		if (tile->getFire())
 		{
-			addLight(_save->getTiles()[i]->getPosition(), fireLightPower, layer);
+			lights.push_back(LightSource(tile->getPosition(), fireLightPower));
 		}
 
-		for (std::vector<BattleItem*>::iterator it = _save->getTiles()[i]->getInventory()->begin(); it != _save->getTiles()[i]->getInventory()->end(); ++it)
+		for (std::vector<BattleItem*>::iterator it = tile->getInventory()->begin(); it != tile->getInventory()->end(); ++it)
 		{
 			if ((*it)->getRules()->getBattleType() == BT_FLARE)
 			{
-				addLight(_save->getTiles()[i]->getPosition(), (*it)->getRules()->getPower(), layer);
+				lights.push_back(LightSource(tile->getPosition(), (*it)->getRules()->getPower()));
 			}
 		}
 
 	}
 
+	applyLights(lights, layer);
 }
 
 /**
@@ -165,58 +170,171 @@ void TileEngine::calculateUnitLighting()
 	const int personalLightPower = 15; // amount of light a unit generates
 	const int fireLightPower = 15; // amount of light a fire generates
 
-	// reset all light to 0 first
-	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
-	{
-		_save->getTiles()[i]->resetLight(layer);
-	}
+	std::vector<LightSource> lights;
 
 	for (std::vector<BattleUnit*>::iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
 	{
 		// add lighting of soldiers
 		if (_personalLighting && (*i)->getFaction() == FACTION_PLAYER && !(*i)->isOut())
 		{
-			addLight((*i)->getPosition(), personalLightPower, layer);
+			lights.push_back(LightSource((*i)->getPosition(), personalLightPower));
 		}
 		// add lighting of units on fire
 		if ((*i)->getFire())
 		{
-			addLight((*i)->getPosition(), fireLightPower, layer);
+			lights.push_back(LightSource((*i)->getPosition(), fireLightPower));
 		}
 	}
+
+	applyLights(lights, layer);
 }
 
 /**
- * Adds circular light pattern starting from center and losing power with distance travelled.
- * @param center Center.
- * @param power Power.
+ * Updates a light layer to a new set of light sources.
+ * Only the columns of tiles in reach of a light that appeared or vanished since the last
+ * update get reset, and only the lights reaching those columns are added back in.
+ * @param lights The light sources currently on the map, gets sorted and kept for the next update.
  * @param layer Light is separated in 3 layers: Ambient, Static and Dynamic.
  */
-void TileEngine::addLight(Position center, int power, int layer)
+void TileEngine::applyLights(std::vector<LightSource> &lights, int layer)
 {
-	// only loop through the positive quadrant.
-	for (int x = 0; x <= power; ++x)
+	const int sizeX = _save->getMapSizeX();
+	const int sizeY = _save->getMapSizeY();
+	std::sort(lights.begin(), lights.end());
+
+	if (_lightMapSize != _save->getMapSizeXYZ() || (int)_lightColumns.size() != sizeX * sizeY)
 	{
-		for (int y = 0; y <= power; ++y)
+		// new map, forget what we lit up before
+		for (int i = 0; i < LIGHTLAYERS; ++i)
+		{
+			_lightLayerValid[i] = false;
+		}
+		_lightMapSize = _save->getMapSizeXYZ();
+		_lightColumns.assign(sizeX * sizeY, false);
+		_lightColumnsMarked.clear();
+	}
+
+	if (_lightLayerValid[layer])
+	{
+		if (lights == _lightSources[layer])
+		{
+			return;
+		}
+		std::vector<LightSource> changed;
+		std::set_symmetric_difference(lights.begin(), lights.end(), _lightSources[layer].begin(), _lightSources[layer].end(), std::back_inserter(changed));
+		for (std::vector<LightSource>::const_iterator i = changed.begin(); i != changed.end(); ++i)
+		{
+			for (int y = std::max(0, i->y - i->power); y <= std::min(sizeY - 1, i->y + i->power); ++y)
+			{
+				for (int x = std::max(0, i->x - i->power); x <= std::min(sizeX - 1, i->x + i->power); ++x)
+				{
+					const int column = y * sizeX + x;
+					if (!_lightColumns[column])
+					{
+						_lightColumns[column] = true;
+						_lightColumnsMarked.push_back(column);
+					}
+				}
+			}
+		}
+
+		// reset light to 0 first
+		for (std::vector<int>::const_iterator i = _lightColumnsMarked.begin(); i != _lightColumnsMarked.end(); ++i)
 		{
 			for (int z = 0; z < _save->getMapSizeZ(); z++)
 			{
-				int distance = (int)Round(sqrt(float(x*x + y*y)));
+				_save->getTile(z * sizeX * sizeY + *i)->resetLight(layer);
+			}
+		}
+	}
+	else
+	{
+		_lightColumns.assign(sizeX * sizeY, true);
 
-				if (_save->getTile(Position(center.x + x,center.y + y, z)))
-					_save->getTile(Position(center.x + x,center.y + y, z))->addLight(power - distance, layer);
+		// reset light to 0 first
+		for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
+		{
+			_save->getTile(i)->resetLight(layer);
+		}
+	}
 
-				if (_save->getTile(Position(center.x - x,center.y - y, z)))
-					_save->getTile(Position(center.x - x,center.y - y, z))->addLight(power - distance, layer);
+	for (std::vector<LightSource>::const_iterator i = lights.begin(); i != lights.end(); ++i)
+	{
+		addLight(*i, layer);
+	}
 
-				if (_save->getTile(Position(center.x - x,center.y + y, z)))
-					_save->getTile(Position(center.x - x,center.y + y, z))->addLight(power - distance, layer);
+	// leave the column marks clear for the next update
+	if (_lightLayerValid[layer])
+	{
+		for (std::vector<int>::const_iterator i = _lightColumnsMarked.begin(); i != _lightColumnsMarked.end(); ++i)
+		{
+			_lightColumns[*i] = false;
+		}
+		_lightColumnsMarked.clear();
+	}
+	else
+	{
+		_lightColumns.assign(sizeX * sizeY, false);
+	}
+
+	_lightSources[layer].swap(lights);
+	_lightLayerValid[layer] = true;
+}
 
-				if (_save->getTile(Position(center.x + x,center.y - y, z)))
-					_save->getTile(Position(center.x + x,center.y - y, z))->addLight(power - distance, layer);
+/**
+ * Adds circular light pattern starting from center and losing power with distance travelled.
+ * Only the columns marked for updating get lit.
+ * @param light The light source.
+ * @param layer Light is separated in 3 layers: Ambient, Static and Dynamic.
+ */
+void TileEngine::addLight(const LightSource &light, int layer)
+{
+	const int sizeX = _save->getMapSizeX();
+	const int sizeY = _save->getMapSizeY();
+	const int levelSize = sizeX * sizeY;
+	for (int y = std::max(0, light.y - light.power); y <= std::min(sizeY - 1, light.y + light.power); ++y)
+	{
+		for (int x = std::max(0, light.x - light.power); x <= std::min(sizeX - 1, light.x + light.power); ++x)
+		{
+			const int column = y * sizeX + x;
+			if (!_lightColumns[column])
+			{
+				continue;
+			}
+			const int power = light.power - lightDistance(abs(x - light.x), abs(y - light.y));
+			if (power <= 0)
+			{
+				continue;
+			}
+			for (int z = 0; z < _save->getMapSizeZ(); z++)
+			{
+				_save->getTile(z * levelSize + column)->addLight(power, layer);
+			}
+		}
+	}
+}
+
+/**
+ * Gets the rounded distance light travels to reach an offset, from a lookup table.
+ * @param x Offset on the x axis, not negative.
+ * @param y Offset on the y axis, not negative.
+ * @return The distance, rounded to the nearest tile.
+ */
+int TileEngine::lightDistance(int x, int y)
+{
+	if (x >= _lightDistanceSize || y >= _lightDistanceSize)
+	{
+		_lightDistanceSize = std::max(std::max(x, y) + 1, std::max(_lightDistanceSize * 2, 16));
+		_lightDistance.resize(_lightDistanceSize * _lightDistanceSize);
+		for (int j = 0; j < _lightDistanceSize; ++j)
+		{
+			for (int i = 0; i < _lightDistanceSize; ++i)
+			{
+				_lightDistance[j * _lightDistanceSize + i] = (int)Round(sqrt(float(i*i + j*j)));
 			}
 		}
 	}
+	return _lightDistance[y * _lightDistanceSize + x];
 }
 
 /**
@@ -1126,6 +1244,7 @@ BattleUnit *TileEngine::hit(Position center, int power, ItemDamageType type, Bat
 		{
 			_save->addDestroyedObjective();
 		}
+		invalidateTerrainCache(tile->getPosition());
 	}
 	else if (part == V_UNIT)
 	{
@@ -1588,6 +1707,7 @@ bool TileEngine::detonate(Tile* tile)
 					tiles[i]->setSmoke(Clamp(smoke, 0, 15));
 				}
 			}
+			invalidateTerrainCache(tiles[i]->getPosition());
 		}
 	}
 	return objective;
@@ -1604,9 +1724,9 @@ Tile *TileEngine::checkForTerrainExplosions()
 {
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		if (_save->getTiles()[i]->getExplosive())
+		if (_save->getTile(i)->getExplosive())
 		{
-			return _save->getTiles()[i];
+			return _save->getTile(i);
 		}
 	}
 	return 0;
@@ -2092,6 +2212,10 @@ int TileEngine::unitOpensDoor(BattleUnit *unit, bool rClick, int dir)
 					if (door != -1)
 					{
 						part = i->second;
+						if (door == 0 || door == 1)
+						{
+							invalidateTerrainCache(tile->getPosition());
+						}
 						if (door == 1)
 						{
 							checkAdjacentDoors(unit->getPosition() + Position(x,y,z) + i->first, i->second);
@@ -2157,6 +2281,7 @@ void TileEngine::checkAdjacentDoors(const Position& pos, TilePart part)
 		if (tile && tile->getMapData(part) && tile->getMapData(part)->isUFODoor())
 		{
 			tile->openDoor(part);
+			invalidateTerrainCache(tile->getPosition());
 		}
 		else break;
 	}
@@ -2167,6 +2292,7 @@ void TileEngine::checkAdjacentDoors(const Position& pos, TilePart part)
 		if (tile && tile->getMapData(part) && tile->getMapData(part)->isUFODoor())
 		{
 			tile->openDoor(part);
+			invalidateTerrainCache(tile->getPosition());
 		}
 		else break;
 	}
@@ -2183,10 +2309,10 @@ int TileEngine::closeUfoDoors()
 	// prepare a list of tiles on fire/smoke & close any ufo doors
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		if (_save->getTiles()[i]->getUnit() && _save->getTiles()[i]->getUnit()->getArmor()->getSize() > 1)
+		if (_save->getTile(i)->getUnit() && _save->getTile(i)->getUnit()->getArmor()->getSize() > 1)
 		{
-			BattleUnit *bu = _save->getTiles()[i]->getUnit();
-			Tile *tile = _save->getTiles()[i];
+			BattleUnit *bu = _save->getTile(i)->getUnit();
+			Tile *tile = _save->getTile(i);
 			Tile *oneTileNorth = _save->getTile(tile->getPosition() + Position(0, -1, 0));
 			Tile *oneTileWest = _save->getTile(tile->getPosition() + Position(-1, 0, 0));
 			if ((tile->isUfoDoorOpen(O_NORTHWALL) && oneTileNorth && oneTileNorth->getUnit() && oneTileNorth->getUnit() == bu) ||
@@ -2195,7 +2321,11 @@ int TileEngine::closeUfoDoors()
 				continue;
 			}
 		}
-		doorsclosed += _save->getTiles()[i]->closeUfoDoor();
+		if (_save->getTile(i)->closeUfoDoor())
+		{
+			invalidateTerrainCache(_save->getTile(i)->getPosition());
+			++doorsclosed;
+		}
 	}
 
 	return doorsclosed;
@@ -2301,22 +2431,11 @@ int TileEngine::calculateLine(Position origin, Position target, bool storeTrajec
 		}
 		else
 		{
-			int temp_res = verticalBlockage(_save->getTile(lastPoint), _save->getTile(Position(cx, cy, cz)), DT_NONE);
-			result = horizontalBlockage(_save->getTile(lastPoint), _save->getTile(Position(cx, cy, cz)), DT_NONE, steps<2);
+			result = lineStepBlockage(lastPoint, Position(cx, cy, cz), steps<2);
 			steps++;
-			if (result == -1)
-			{
-				if (temp_res > 127)
-				{
-					result = 0;
-				} else {
-				return result; // We hit a big wall
-				}
-			}
-			result += temp_res;
-			if (result > 127)
+			if (result == -1 || result > 127)
 			{
-				return result;
+				return result; // We hit a big wall, or something opaque
 			}
 
 			lastPoint = Position(cx, cy, cz);
@@ -2380,6 +2499,95 @@ int TileEngine::calculateLine(Position origin, Position target, bool storeTrajec
 	return V_EMPTY;
 }
 
+/**
+ * Calculates the blockage of a single tile-space step of a line of sight.
+ * Terrain only changes when something gets destroyed or a door opens or closes,
+ * so results for whole-map visibility sweeps are cached per tile and direction
+ * until invalidateTerrainCache() is called for a nearby tile.
+ * @param from The tile the step starts on.
+ * @param to The adjacent tile the step ends on.
+ * @param skipObject Ignore the object on the starting tile (first step of a line).
+ * @return -1 for a big wall, over 127 for an opaque step, anything else lets the line pass.
+ */
+int TileEngine::lineStepBlockage(Position from, Position to, bool skipObject)
+{
+	Tile *startTile = _save->getTile(from);
+	Tile *endTile = _save->getTile(to);
+	Sint16 *cached = 0;
+	// only the first step of a line skips objects, not worth caching
+	if (!skipObject && startTile && endTile)
+	{
+		const size_t cacheSize = _save->getMapSizeXYZ() * 27;
+		if (_blockageCache.size() != cacheSize)
+		{
+			_blockageCache.assign(cacheSize, BLOCKAGE_UNKNOWN);
+		}
+		Position dir = to - from;
+		cached = &_blockageCache[_save->getTileIndex(from) * 27 + (dir.x + 1) * 9 + (dir.y + 1) * 3 + (dir.z + 1)];
+		if (*cached != BLOCKAGE_UNKNOWN)
+		{
+			return *cached;
+		}
+	}
+
+	int vertical = verticalBlockage(startTile, endTile, DT_NONE);
+	int result = horizontalBlockage(startTile, endTile, DT_NONE, skipObject);
+	if (result == -1 && vertical <= 127)
+	{
+		result = -1; // We hit a big wall
+	}
+	else
+	{
+		if (result == -1)
+		{
+			result = 0;
+		}
+		result += vertical;
+	}
+
+	if (cached)
+	{
+		*cached = result;
+	}
+	return result;
+}
+
+/**
+ * Drops the cached terrain voxels of the given tile and the cached line of sight
+ * blockage of every step touching it. Must be called whenever a tile part
+ * is destroyed, replaced or a door on it opens or closes.
+ * @param pos Position of the changed tile.
+ */
+void TileEngine::invalidateTerrainCache(Position pos)
+{
+	_save->getPathfinding()->invalidateTerrainCache(pos);
+	if (_terrainVoxelBlock.size() == (size_t)_save->getMapSizeXYZ() && _save->getTile(pos))
+	{
+		_terrainVoxelBlock[_save->getTileIndex(pos)] = -1;
+	}
+	if (_blockageCache.size() != (size_t)_save->getMapSizeXYZ() * 27)
+	{
+		_blockageCache.clear();
+		return;
+	}
+	// a step from a tile looks at its direct neighbours, so anything starting next to this tile is affected
+	for (int z = pos.z - 1; z <= pos.z + 1; ++z)
+	{
+		for (int y = pos.y - 1; y <= pos.y + 1; ++y)
+		{
+			for (int x = pos.x - 1; x <= pos.x + 1; ++x)
+			{
+				Position p(x, y, z);
+				if (_save->getTile(p))
+				{
+					std::vector<Sint16>::iterator first = _blockageCache.begin() + _save->getTileIndex(p) * 27;
+					std::fill(first, first + 27, BLOCKAGE_UNKNOWN);
+				}
+			}
+		}
+	}
+}
+
 /**
  * Calculates a parabola trajectory, used for throwing items.
  * @param origin Origin in voxelspace.
@@ -2549,20 +2757,25 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 	}
 
 	// first we check terrain voxel data, not to allow 2x2 units stick through walls
-	for (int i = V_FLOOR; i <= V_OBJECT; ++i)
+	// the merged terrain voxels tell us if anything is here at all, the parts only need checking on a hit
+	const Uint16 *terrain = getTerrainVoxels(_save->getTileIndex(pos));
+	if (terrain[((voxel.z%24)/2)*16 + voxel.y%16] & (1 << (15 - voxel.x%16)))
 	{
-		TilePart tp = (TilePart)i;
-		MapData *mp = tile->getMapData(tp);
-		if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
-			continue;
-		if (mp != 0)
+		for (int i = V_FLOOR; i <= V_OBJECT; ++i)
 		{
-			int x = 15 - voxel.x%16;
-			int y = voxel.y%16;
-			int idx = (mp->getLoftID((voxel.z%24)/2)*16) + y;
-			if (_voxelData->at(idx) & (1 << x))
+			TilePart tp = (TilePart)i;
+			MapData *mp = tile->getMapData(tp);
+			if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
+				continue;
+			if (mp != 0)
 			{
-				return (VoxelType)i;
+				int x = 15 - voxel.x%16;
+				int y = voxel.y%16;
+				int idx = (mp->getLoftID((voxel.z%24)/2)*16) + y;
+				if (_voxelData->at(idx) & (1 << x))
+				{
+					return (VoxelType)i;
+				}
 			}
 		}
 	}
@@ -2625,6 +2838,61 @@ void TileEngine::voxelCheckFlush()
 	_cacheTileBelow = 0;
 }
 
+/**
+ * Gets the terrain voxels of a tile, with all its parts merged together.
+ * Tiles made of the same parts share the same block, which is built
+ * the first time it is needed.
+ * @param index Index of the tile.
+ * @return Pointer to the 12 layers of 16 voxel rows of the tile.
+ */
+const Uint16 *TileEngine::getTerrainVoxels(int index)
+{
+	if (_terrainVoxelBlock.size() != (size_t)_save->getMapSizeXYZ())
+	{
+		_terrainVoxelBlock.assign(_save->getMapSizeXYZ(), -1);
+	}
+	int &block = _terrainVoxelBlock[index];
+	if (block == -1)
+	{
+		Tile *tile = _save->getTile(index);
+		TerrainVoxelKey key;
+		for (int i = O_FLOOR; i <= O_OBJECT; ++i)
+		{
+			TilePart tp = (TilePart)i;
+			key.parts[i] = tile->getMapData(tp);
+			// open ufo doors don't stop anything
+			if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
+				key.parts[i] = 0;
+		}
+		std::map<TerrainVoxelKey, int>::const_iterator i = _terrainVoxelKeys.find(key);
+		if (i != _terrainVoxelKeys.end())
+		{
+			block = i->second;
+		}
+		else
+		{
+			block = _terrainVoxels.size() / TERRAIN_VOXEL_BLOCK;
+			_terrainVoxels.resize(_terrainVoxels.size() + TERRAIN_VOXEL_BLOCK, 0);
+			Uint16 *voxels = &_terrainVoxels[block * TERRAIN_VOXEL_BLOCK];
+			for (int part = 0; part < 4; ++part)
+			{
+				if (key.parts[part] == 0)
+					continue;
+				for (int layer = 0; layer < 12; ++layer)
+				{
+					int idx = key.parts[part]->getLoftID(layer) * 16;
+					for (int y = 0; y < 16; ++y)
+					{
+						voxels[layer * 16 + y] |= _voxelData->at(idx + y);
+					}
+				}
+			}
+			_terrainVoxelKeys[key] = block;
+		}
+	}
+	return &_terrainVoxels[block * TERRAIN_VOXEL_BLOCK];
+}
+
 /**
  * Toggles personal lighting on / off.
  */
@@ -18,6 +18,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <map>
+#include <functional>
 #include "Position.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/MapData.h"
@@ -45,12 +47,61 @@ private:
 	SavedBattleGame *_save;
 	std::vector<Uint16> *_voxelData;
 	static const int heightFromCenter[11];
-	void addLight(Position center, int power, int layer);
+	static const int LIGHTLAYERS = 3;
+	/// A light source, it lights up whole columns of tiles, so only x and y matter.
+	struct LightSource
+	{
+		int x, y, power;
+		LightSource(Position pos, int power_) : x(pos.x), y(pos.y), power(power_) {}
+		bool operator<(const LightSource &other) const
+		{
+			if (x != other.x) return x < other.x;
+			if (y != other.y) return y < other.y;
+			return power < other.power;
+		}
+		bool operator==(const LightSource &other) const
+		{
+			return x == other.x && y == other.y && power == other.power;
+		}
+	};
+	std::vector<LightSource> _lightSources[LIGHTLAYERS];
+	bool _lightLayerValid[LIGHTLAYERS];
+	int _lightMapSize;
+	std::vector<int> _lightDistance;
+	int _lightDistanceSize;
+	std::vector<bool> _lightColumns;
+	std::vector<int> _lightColumnsMarked;
+	void applyLights(std::vector<LightSource> &lights, int layer);
+	void addLight(const LightSource &light, int layer);
+	int lightDistance(int x, int y);
 	int blockage(Tile *tile, const TilePart part, ItemDamageType type, int direction = -1, bool checkingFromOrigin = false);
 	bool _personalLighting;
 	Tile *_cacheTile;
 	Tile *_cacheTileBelow;
 	Position _cacheTilePos;
+	static const Sint16 BLOCKAGE_UNKNOWN = -2;
+	std::vector<Sint16> _blockageCache;
+	int lineStepBlockage(Position from, Position to, bool skipObject);
+	/// Voxel rows of one tile: 12 layers of 16 rows of 16 bits.
+	static const int TERRAIN_VOXEL_BLOCK = 12 * 16;
+	/// The tile parts that make up a block of terrain voxels.
+	struct TerrainVoxelKey
+	{
+		MapData *parts[4];
+		bool operator<(const TerrainVoxelKey &other) const
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				if (parts[i] != other.parts[i])
+					return std::less<MapData*>()(parts[i], other.parts[i]);
+			}
+			return false;
+		}
+	};
+	std::vector<Uint16> _terrainVoxels;
+	std::vector<int> _terrainVoxelBlock;
+	std::map<TerrainVoxelKey, int> _terrainVoxelKeys;
+	const Uint16 *getTerrainVoxels(int index);
 public:
 	/// Creates a new TileEngine class.
 	TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData);
@@ -120,6 +171,8 @@ public:
 	VoxelType voxelCheck(Position voxel, BattleUnit *excludeUnit, bool excludeAllUnits = false, bool onlyVisible = false, BattleUnit *excludeAllBut = 0);
 	/// Flushes cache of voxel check
 	void voxelCheckFlush();
+	/// Drops cached terrain data around a changed tile.
+	void invalidateTerrainCache(Position pos);
 	/// Blows this tile up.
 	bool detonate(Tile* tile);
 	/// Validates a throwing action.
@@ -0,0 +1,343 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BinaryYaml.h"
+#include "Exception.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+// node type tags, the low bits of the first byte of every node
+const Uint8 NODE_NULL = 0;
+const Uint8 NODE_SCALAR = 1;
+const Uint8 NODE_SEQUENCE = 2;
+const Uint8 NODE_MAP = 3;
+const Uint8 NODE_TYPE_MASK = 0x0F;
+// extra node details
+const Uint8 NODE_FLOW = 0x10;
+const Uint8 NODE_TAG = 0x20;
+
+// strings up to this size are pooled, longer ones are rarely repeated
+const size_t MAX_POOLED_STRING = 64;
+
+}
+
+/**
+ * Creates an empty binary writer.
+ */
+BinaryYamlWriter::BinaryYamlWriter()
+{
+}
+
+/**
+ * Cleans up the binary writer.
+ */
+BinaryYamlWriter::~BinaryYamlWriter()
+{
+}
+
+/**
+ * Writes a string, as a reference to an earlier
+ * copy of it if there was one.
+ * @param s String to write.
+ */
+void BinaryYamlWriter::writeString(const std::string &s)
+{
+	if (s.size() <= MAX_POOLED_STRING)
+	{
+		std::map<std::string, size_t>::const_iterator i = _strings.find(s);
+		if (i != _strings.end())
+		{
+			writeSize(i->second * 2 + 1);
+			return;
+		}
+		size_t index = _strings.size();
+		_strings[s] = index;
+	}
+	writeSize(s.size() * 2);
+	writeBytes(s.data(), s.size());
+}
+
+/**
+ * Writes a YAML node and all its children.
+ * Flow style and explicit tags are kept, comments
+ * and source positions are not.
+ * @param node YAML node.
+ */
+void BinaryYamlWriter::writeNode(const YAML::Node &node)
+{
+	Uint8 type;
+	switch (node.Type())
+	{
+	case YAML::NodeType::Scalar:
+		type = NODE_SCALAR;
+		break;
+	case YAML::NodeType::Sequence:
+		type = NODE_SEQUENCE;
+		break;
+	case YAML::NodeType::Map:
+		type = NODE_MAP;
+		break;
+	default:
+		type = NODE_NULL;
+		break;
+	}
+	if (type >= NODE_SEQUENCE && node.Style() == YAML::EmitterStyle::Flow)
+	{
+		type |= NODE_FLOW;
+	}
+	// "?" and "!" only say if a scalar was quoted, which doesn't change its value
+	const std::string &tag = node.Tag();
+	bool hasTag = type != NODE_NULL && !tag.empty() && tag != "?" && tag != "!";
+	if (hasTag)
+	{
+		type |= NODE_TAG;
+	}
+
+	_data.push_back(type);
+	if (hasTag)
+	{
+		writeString(tag);
+	}
+	switch (type & NODE_TYPE_MASK)
+	{
+	case NODE_SCALAR:
+		writeString(node.Scalar());
+		break;
+	case NODE_SEQUENCE:
+		writeSize(node.size());
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			writeNode(*i);
+		}
+		break;
+	case NODE_MAP:
+		writeSize(node.size());
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			writeNode(i->first);
+			writeNode(i->second);
+		}
+		break;
+	}
+}
+
+/**
+ * Writes an unsigned number in as few bytes as
+ * possible, seven bits at a time.
+ * @param value Number to write.
+ */
+void BinaryYamlWriter::writeSize(size_t value)
+{
+	while (value >= 0x80)
+	{
+		_data.push_back((Uint8)(value | 0x80));
+		value >>= 7;
+	}
+	_data.push_back((Uint8)value);
+}
+
+/**
+ * Writes a block of raw bytes.
+ * @param data Pointer to the bytes.
+ * @param size Number of bytes.
+ */
+void BinaryYamlWriter::writeBytes(const void *data, size_t size)
+{
+	const Uint8 *bytes = (const Uint8*)data;
+	_data.insert(_data.end(), bytes, bytes + size);
+}
+
+/**
+ * Gets the data written so far.
+ * @return Binary data.
+ */
+std::vector<Uint8> &BinaryYamlWriter::getData()
+{
+	return _data;
+}
+
+/**
+ * Creates a binary reader for a block of data.
+ * The data must stay valid while it's being read.
+ * @param data Pointer to the data.
+ * @param size Size of the data.
+ */
+BinaryYamlReader::BinaryYamlReader(const Uint8 *data, size_t size) : _pos(data), _end(data + size)
+{
+}
+
+/**
+ * Cleans up the binary reader.
+ */
+BinaryYamlReader::~BinaryYamlReader()
+{
+}
+
+/**
+ * Reads a string, either stored in place
+ * or as a reference to an earlier one.
+ * @return The string.
+ */
+const std::string &BinaryYamlReader::readString()
+{
+	size_t code = readSize();
+	if (code & 1)
+	{
+		size_t index = code / 2;
+		if (index >= _strings.size())
+		{
+			throw Exception("Invalid string reference in binary data");
+		}
+		return _strings[index];
+	}
+	size_t size = code / 2;
+	const char *s = (const char*)readBytes(size);
+	if (size <= MAX_POOLED_STRING)
+	{
+		_strings.push_back(std::string(s, size));
+		return _strings.back();
+	}
+	_scratch.assign(s, size);
+	return _scratch;
+}
+
+/**
+ * Reads a YAML node and all its children.
+ * @return YAML node.
+ */
+YAML::Node BinaryYamlReader::readNode()
+{
+	YAML::Node node;
+	readNode(node);
+	return node;
+}
+
+/**
+ * Reads a YAML node and all its children into an existing node.
+ * Children are added to their parent before they are filled in,
+ * so yaml-cpp never has to merge a whole subtree into the parent.
+ * @param node YAML node to fill in.
+ */
+void BinaryYamlReader::readNode(YAML::Node &node)
+{
+	Uint8 type = *readBytes(1);
+	std::string tag;
+	if (type & NODE_TAG)
+	{
+		tag = readString();
+	}
+
+	switch (type & NODE_TYPE_MASK)
+	{
+	case NODE_NULL:
+		node = YAML::Null;
+		break;
+	case NODE_SCALAR:
+		node = readString();
+		break;
+	case NODE_SEQUENCE:
+		{
+			node = YAML::Node(YAML::NodeType::Sequence);
+			size_t size = readSize();
+			for (size_t i = 0; i < size; ++i)
+			{
+				YAML::Node item(YAML::NodeType::Null);
+				node.push_back(item);
+				readNode(item);
+			}
+		}
+		break;
+	case NODE_MAP:
+		{
+			node = YAML::Node(YAML::NodeType::Map);
+			size_t size = readSize();
+			for (size_t i = 0; i < size; ++i)
+			{
+				YAML::Node key(YAML::NodeType::Null), value(YAML::NodeType::Null);
+				readNode(key);
+				// keys were unique when written, so skip the lookup
+				node.force_insert(key, value);
+				readNode(value);
+			}
+		}
+		break;
+	default:
+		throw Exception("Invalid node type in binary data");
+	}
+	if (type & NODE_FLOW)
+	{
+		node.SetStyle(YAML::EmitterStyle::Flow);
+	}
+	if (type & NODE_TAG)
+	{
+		node.SetTag(tag);
+	}
+}
+
+/**
+ * Reads an unsigned number written by BinaryYamlWriter::writeSize().
+ * @return The number.
+ */
+size_t BinaryYamlReader::readSize()
+{
+	size_t value = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		if (_pos == _end || shift >= (int)sizeof(size_t) * 8)
+		{
+			throw Exception("Invalid number in binary data");
+		}
+		Uint8 byte = *_pos++;
+		value |= (size_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+		{
+			return value;
+		}
+	}
+}
+
+/**
+ * Reads a block of raw bytes.
+ * @param size Number of bytes.
+ * @return Pointer to the bytes, valid as long as the data is.
+ */
+const Uint8 *BinaryYamlReader::readBytes(size_t size)
+{
+	if (size > (size_t)(_end - _pos))
+	{
+		throw Exception("Binary data is truncated");
+	}
+	const Uint8 *bytes = _pos;
+	_pos += size;
+	return bytes;
+}
+
+/**
+ * Checks if all the data has been read.
+ * @return True if there's nothing left.
+ */
+bool BinaryYamlReader::atEnd() const
+{
+	return _pos == _end;
+}
+
+}
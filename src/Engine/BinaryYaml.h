@@ -0,0 +1,83 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include <yaml-cpp/yaml.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Writes YAML node trees in a compact binary form that
+ * reads back much faster than YAML text can be parsed.
+ * Every node starts with a type tag, and short strings
+ * are pooled so repeated keys are only stored once.
+ */
+class BinaryYamlWriter
+{
+private:
+	std::vector<Uint8> _data;
+	std::map<std::string, size_t> _strings;
+	void writeString(const std::string &s);
+public:
+	/// Creates an empty binary writer.
+	BinaryYamlWriter();
+	/// Cleans up the binary writer.
+	~BinaryYamlWriter();
+	/// Writes a YAML node tree.
+	void writeNode(const YAML::Node &node);
+	/// Writes an unsigned number.
+	void writeSize(size_t value);
+	/// Writes raw bytes.
+	void writeBytes(const void *data, size_t size);
+	/// Gets the data written so far.
+	std::vector<Uint8> &getData();
+};
+
+/**
+ * Reads YAML node trees back from the binary form
+ * written by BinaryYamlWriter.
+ */
+class BinaryYamlReader
+{
+private:
+	const Uint8 *_pos, *_end;
+	std::vector<std::string> _strings;
+	std::string _scratch;
+	const std::string &readString();
+	void readNode(YAML::Node &node);
+public:
+	/// Creates a binary reader for a block of data.
+	BinaryYamlReader(const Uint8 *data, size_t size);
+	/// Cleans up the binary reader.
+	~BinaryYamlReader();
+	/// Reads a YAML node tree.
+	YAML::Node readNode();
+	/// Reads an unsigned number.
+	size_t readSize();
+	/// Reads raw bytes.
+	const Uint8 *readBytes(size_t size);
+	/// Checks if all the data has been read.
+	bool atEnd() const;
+};
+
+}
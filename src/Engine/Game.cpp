@@ -148,6 +148,7 @@ void Game::run()
 	while (!_quit)
 	{
 		Uint32 timeFrameStarted = SDL_GetTicks();
+		Logger::flush();
 		// Clean up states
 		while (!_deleted.empty())
 		{
@@ -23,6 +23,8 @@
 #include <sstream>
 #include <string>
 #include <stdio.h>
+#include <time.h>
+#include <SDL_mutex.h>
 #include "CrossPlatform.h"
 
 namespace OpenXcom
@@ -57,18 +59,25 @@ public:
 	static SeverityLevel& reportingLevel();
 	static std::string& logFile();
 	static std::string toString(SeverityLevel level);
+	static void flush(bool force = false);
 protected:
 	std::ostringstream os;
+	SeverityLevel _level;
 private:
 	Logger(const Logger&);
+	static SDL_mutex *mutex();
+	static FILE *logStream();
+	static bool& pendingFlush();
+	static void flushStream(bool force);
 };
 
-inline Logger::Logger()
+inline Logger::Logger() : _level(LOG_INFO)
 {
 }
 
 inline std::ostringstream& Logger::get(SeverityLevel level)
 {
+	_level = level;
 	os << "[" << toString(level) << "]" << "\t";
 	return os;
 }
@@ -78,18 +87,21 @@ inline Logger::~Logger()
 	os << std::endl;
 	std::ostringstream ss;
 	ss << "[" << CrossPlatform::now() << "]" << "\t" << os.str();
-	FILE *file = fopen(logFile().c_str(), "a");
+	SDL_LockMutex(mutex());
+	FILE *file = logStream();
 	if (file)
 	{
 		fprintf(file, "%s", ss.str().c_str());
-		fflush(file);
-		fclose(file);
+		pendingFlush() = true;
+		// bad news has to hit the disk right away in case we're about to crash
+		flushStream(_level <= LOG_WARNING);
 	}
 	if (!file || reportingLevel() == LOG_DEBUG || reportingLevel() == LOG_VERBOSE)
 	{
 		fprintf(stderr, "%s", os.str().c_str());
 		fflush(stderr);
 	}
+	SDL_UnlockMutex(mutex());
 }
 
 inline SeverityLevel& Logger::reportingLevel()
@@ -104,6 +116,78 @@ inline std::string& Logger::logFile()
 	return logFile;
 }
 
+/**
+ * Writes buffered lines to the log file, at most once
+ * a second unless forced. Game::run() calls this every
+ * frame so lines don't linger when nothing else is logged.
+ * @param force Flush even if the last flush was recent.
+ */
+inline void Logger::flush(bool force)
+{
+	SDL_LockMutex(mutex());
+	flushStream(force);
+	SDL_UnlockMutex(mutex());
+}
+
+/**
+ * Does the work of flush(), the caller must hold the log mutex.
+ * @param force Flush even if the last flush was recent.
+ */
+inline void Logger::flushStream(bool force)
+{
+	static time_t lastFlush = 0;
+	time_t now = time(0);
+	if (pendingFlush() && (force || now - lastFlush >= 1))
+	{
+		FILE *file = logStream();
+		if (file)
+		{
+			fflush(file);
+		}
+		pendingFlush() = false;
+		lastFlush = now;
+	}
+}
+
+/**
+ * Guards the log file and its flush state, since the
+ * loading and save threads log alongside the main thread.
+ * The first message is logged before any of them start,
+ * so the mutex is always created on the main thread.
+ */
+inline SDL_mutex *Logger::mutex()
+{
+	static SDL_mutex *mutex = SDL_CreateMutex();
+	return mutex;
+}
+
+inline bool& Logger::pendingFlush()
+{
+	static bool pending = false;
+	return pending;
+}
+
+/**
+ * Keeps the log file open between messages,
+ * only reopening it when the file name changes.
+ * The C library flushes it when the game exits.
+ */
+inline FILE *Logger::logStream()
+{
+	static FILE *file = 0;
+	static std::string fileName;
+	if (fileName != logFile())
+	{
+		if (file)
+		{
+			fclose(file);
+		}
+		fileName = logFile();
+		file = fopen(fileName.c_str(), "a");
+	}
+	return file;
+}
+
 inline std::string Logger::toString(SeverityLevel level)
 {
 	static const char* const buffer[] = {"FATAL", "ERROR", "WARN", "INFO", "DEBUG", "VERB"};
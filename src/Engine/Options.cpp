@@ -34,6 +34,7 @@
 #include "CrossPlatform.h"
 #include "FileMap.h"
 #include "Screen.h"
+#include "RNG.h"
 
 namespace OpenXcom
 {
@@ -50,6 +51,10 @@ std::string _userFolder;
 std::string _configFolder;
 std::vector<std::string> _userList;
 std::map<std::string, std::string> _commandLine;
+std::string _seed;
+std::string _saveTool, _saveToolFile;
+int _simulateMonths;
+std::string _simulateSave, _simulateMetrics;
 std::vector<OptionInfo> _info;
 std::map<std::string, ModInfo> _modInfos;
 std::string _masterMod;
@@ -131,6 +136,7 @@ void create()
 	_info.push_back(OptionInfo("cursorInBlackBandsInWindow", &cursorInBlackBandsInWindow, true));
 	_info.push_back(OptionInfo("cursorInBlackBandsInBorderlessWindow", &cursorInBlackBandsInBorderlessWindow, false));
 	_info.push_back(OptionInfo("saveOrder", (int*)&saveOrder, SORT_DATE_DESC));
+	_info.push_back(OptionInfo("saveFormat", (int*)&saveFormat, SAVE_FORMAT_YAML));
 	_info.push_back(OptionInfo("geoClockSpeed", &geoClockSpeed, 80));
 	_info.push_back(OptionInfo("dogfightSpeed", &dogfightSpeed, 30));
 	_info.push_back(OptionInfo("geoScrollSpeed", &geoScrollSpeed, 20));
@@ -142,6 +148,7 @@ void create()
 	_info.push_back(OptionInfo("touchEnabled", &touchEnabled, false));
 	_info.push_back(OptionInfo("rootWindowedMode", &rootWindowedMode, false));
 	_info.push_back(OptionInfo("lazyLoadResources", &lazyLoadResources, true));
+	_info.push_back(OptionInfo("rulesetCache", &rulesetCache, true));
 
 	// advanced options
 	_info.push_back(OptionInfo("playIntro", &playIntro, true, "STR_PLAYINTRO", "STR_GENERAL"));
@@ -380,6 +387,34 @@ void loadArgs(int argc, char *argv[])
 				{
 					_configFolder = CrossPlatform::endPath(argv[i]);
 				}
+				else if (argname == "seed")
+				{
+					// applied in init() once the log file is set up
+					_seed = argv[i];
+				}
+				else if (argname == "convertsave" || argname == "benchsave")
+				{
+					// run by main() instead of the game
+					_saveTool = argname;
+					_saveToolFile = argv[i];
+				}
+				else if (argname == "simulate")
+				{
+					// anything but a positive number is reported when the simulation starts
+					std::istringstream ss(argv[i]);
+					if (!(ss >> _simulateMonths) || !ss.eof() || _simulateMonths <= 0)
+					{
+						_simulateMonths = -1;
+					}
+				}
+				else if (argname == "simulatesave")
+				{
+					_simulateSave = argv[i];
+				}
+				else if (argname == "simulatemetrics")
+				{
+					_simulateMetrics = argv[i];
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -410,6 +445,18 @@ bool showHelp(int argc, char *argv[])
 	help << "        use PATH as the default User Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-cfg PATH  or  -config PATH" << std::endl;
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
+	help << "-seed NUMBER" << std::endl;
+	help << "        start the random number generator from NUMBER instead of the clock, so new games play out the same way" << std::endl << std::endl;
+	help << "-convertSave FILE" << std::endl;
+	help << "        rewrite save FILE in the format set by the saveFormat option (0 = YAML, 1 = binary, 2 = compressed binary) and exit" << std::endl << std::endl;
+	help << "-benchSave FILE" << std::endl;
+	help << "        time reading and writing save FILE in every save format and exit" << std::endl << std::endl;
+	help << "-simulate MONTHS" << std::endl;
+	help << "        play MONTHS months of the Geoscape without a window or a player, write monthly metrics and exit" << std::endl << std::endl;
+	help << "-simulateSave FILE" << std::endl;
+	help << "        start the simulation from save FILE in the User Folder instead of a new game on Beginner" << std::endl << std::endl;
+	help << "-simulateMetrics FILE" << std::endl;
+	help << "        write the simulation metrics to FILE instead of simulation.csv in the User Folder" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        set option KEY to VALUE instead of default/loaded value (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -438,6 +485,52 @@ bool showHelp(int argc, char *argv[])
 
 const std::map<std::string, ModInfo> &getModInfos() { return _modInfos; }
 
+/**
+ * Gets the save file tool picked on the command line,
+ * "convertsave" or "benchsave", if any.
+ * @return Tool name, or empty to run the game.
+ */
+const std::string &getSaveTool()
+{
+	return _saveTool;
+}
+
+/**
+ * Gets the save file the save file tool works on.
+ * @return Path to the save file.
+ */
+const std::string &getSaveToolFile()
+{
+	return _saveToolFile;
+}
+
+/**
+ * Gets the number of months to simulate picked on the command line.
+ * @return Number of months, 0 to run the game, or -1 if it wasn't a valid number.
+ */
+int getSimulateMonths()
+{
+	return _simulateMonths;
+}
+
+/**
+ * Gets the save file to start the simulation from.
+ * @return Save filename, or empty for a new game.
+ */
+const std::string &getSimulateSave()
+{
+	return _simulateSave;
+}
+
+/**
+ * Gets the file to write the simulation metrics to.
+ * @return Path to the metrics file, or empty for the default.
+ */
+const std::string &getSimulateMetrics()
+{
+	return _simulateMetrics;
+}
+
 static void _scanMods(const std::string &modsDir)
 {
 	if (!CrossPlatform::folderExists(modsDir))
@@ -545,6 +638,23 @@ bool init(int argc, char *argv[])
 	}
 	Log(LOG_INFO) << "User folder is: " << _userFolder;
 	Log(LOG_INFO) << "Config folder is: " << _configFolder;
+	if (!_seed.empty())
+	{
+		uint64_t seed = 0;
+		std::istringstream ss(_seed);
+		ss >> seed;
+		// the generator gets stuck on zero, don't let "12abc" pass as 12
+		// and don't let "-1" wrap around to the largest seed
+		if (seed != 0 && ss.eof() && _seed.find('-') == std::string::npos)
+		{
+			RNG::setSeed(seed);
+		}
+		else
+		{
+			Log(LOG_WARNING) << "Invalid seed: " << _seed;
+		}
+	}
+	Log(LOG_INFO) << "RNG seed is: " << RNG::getSeed();
 	Log(LOG_INFO) << "Options loaded successfully.";
 
 	return true;
@@ -32,6 +32,8 @@ enum ScrollType { SCROLL_NONE, SCROLL_TRIGGER, SCROLL_AUTO };
 enum KeyboardType { KEYBOARD_OFF, KEYBOARD_ON, KEYBOARD_VIRTUAL };
 /// Savegame sorting modes.
 enum SaveSort { SORT_NAME_ASC, SORT_NAME_DESC, SORT_DATE_ASC, SORT_DATE_DESC };
+/// Savegame file formats.
+enum SaveFormat { SAVE_FORMAT_YAML, SAVE_FORMAT_BINARY, SAVE_FORMAT_COMPRESSED };
 /// Music format preferences.
 enum MusicFormat { MUSIC_AUTO, MUSIC_FLAC, MUSIC_OGG, MUSIC_MP3, MUSIC_MOD, MUSIC_WAV, MUSIC_ADLIB, MUSIC_GM, MUSIC_MIDI };
 /// Sound format preferences.
@@ -111,6 +113,16 @@ namespace Options
 	void updateMods();
 	/// Gets the list of currently active mods.
 	std::vector<const ModInfo*> getActiveMods();
+	/// Gets the save file tool picked on the command line.
+	const std::string &getSaveTool();
+	/// Gets the save file for the save file tool.
+	const std::string &getSaveToolFile();
+	/// Gets the number of months for a batch simulation.
+	int getSimulateMonths();
+	/// Gets the save file to start a batch simulation from.
+	const std::string &getSimulateSave();
+	/// Gets the file for the batch simulation metrics.
+	const std::string &getSimulateMetrics();
 }
 
 }
@@ -116,6 +116,7 @@ Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _sc
  */
 Screen::~Screen()
 {
+	Zoom::shutdown();
 	delete _surface;
 }
 
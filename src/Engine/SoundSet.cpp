@@ -103,10 +103,9 @@ void SoundSet::loadCat(const std::string &filename, bool wav)
 				// scale to 8 bits
 				for (unsigned int n = 0; n < size; ++n) sound[5 + n] *= 4;
 
-				// copy and do the conversion...
+				// copy the header and do the conversion, it writes every sample
 				newsound = new unsigned char[headerSize + size*2];
 				memcpy(newsound, header, headerSize);
-				memcpy(newsound + headerSize, sound + 5, size);
 				int newsize = convertSampleRate(sound + 5, size, newsound + headerSize);
 				size = newsize + headerSize;
 
@@ -125,8 +124,8 @@ void SoundSet::loadCat(const std::string &filename, bool wav)
 			// rewrite the samplerate in the header to 11 khz
 			sound[0x18]=0x11; sound[0x19]=0x2B; sound[0x1C]=0x11; sound[0x1D]=0x2B;
 
-			// copy and do the conversion...
-			memcpy(sound2, sound, size);
+			// copy the header and do the conversion, it writes every sample
+			memcpy(sound2, sound, headerSize);
 			int newsize = convertSampleRate(sound + headerSize, size - headerSize, sound2 + headerSize);
 			size = newsize + headerSize;
 
@@ -30,6 +30,7 @@
 #include "Logger.h"
 #include "ShaderMove.h"
 #include "Unicode.h"
+#include "Zoom.h"
 #include <stdlib.h>
 #ifdef _WIN32
 #include <malloc.h>
@@ -41,6 +42,14 @@
 #ifdef __MORPHOS__
 #include <ppcinline/exec.h>
 #endif
+#if (_MSC_VER >= 1400) || (defined(__MINGW32__) && defined(__SSE2__))
+#ifndef __SSE2__
+#define __SSE2__ true
+#endif
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace OpenXcom
 {
@@ -951,6 +960,91 @@ struct StandardShade
 
 
 
+/**
+ * Shades one row of pixels, the same way as StandardShade and ColorReplace.
+ * @param dest destination row
+ * @param src source row
+ * @param width number of pixels in the row
+ * @param shade value of shade, not negative
+ * @param newColor new color to set (already shifted by 4), or -1 to keep the source color
+ */
+static void shadeRow(Uint8 *dest, const Uint8 *src, int width, int shade, int newColor)
+{
+	int x = 0;
+#ifdef __SSE2__
+	static bool haveSSE2 = Zoom::haveSSE2();
+	if (haveSSE2)
+	{
+		// anything past 15 turns every pixel black, so the shade fits in a byte
+		const __m128i vShade = _mm_set1_epi8((char)std::min(shade, 16));
+		const __m128i vShadeMask = _mm_set1_epi8(15);
+		const __m128i vGroupMask = _mm_set1_epi8((char)(15<<4));
+		const __m128i vColor = _mm_set1_epi8((char)newColor);
+		const __m128i vZero = _mm_setzero_si128();
+		for (; x + 16 <= width; x += 16)
+		{
+			const __m128i s = _mm_loadu_si128((const __m128i*)(src + x));
+			const __m128i d = _mm_loadu_si128((const __m128i*)(dest + x));
+			const __m128i newShade = _mm_add_epi8(_mm_and_si128(s, vShadeMask), vShade);
+			const __m128i tooDark = _mm_cmpgt_epi8(newShade, vShadeMask);
+			const __m128i group = newColor < 0 ? _mm_and_si128(s, vGroupMask) : vColor;
+			__m128i result = _mm_or_si128(group, newShade);
+			result = _mm_or_si128(_mm_and_si128(tooDark, vShadeMask), _mm_andnot_si128(tooDark, result));
+			// transparent source pixels keep the destination
+			const __m128i transparent = _mm_cmpeq_epi8(s, vZero);
+			result = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, result));
+			_mm_storeu_si128((__m128i*)(dest + x), result);
+		}
+	}
+#endif
+	for (; x < width; ++x)
+	{
+		if (newColor < 0)
+			StandardShade::func(dest[x], src[x], shade, 0, 0);
+		else
+			ColorReplace::func(dest[x], src[x], shade, newColor, 0);
+	}
+}
+
+/**
+ * Blits a surface with shading row by row, clipped the same way as ShaderDraw does it.
+ * @param dest destination surface
+ * @param src source surface
+ * @param shade shade offset
+ * @param newColor new color to set (already shifted by 4), or -1 to keep the source color
+ */
+static void shadeBlit(const ShaderMove<Uint8> &dest, const ShaderMove<Uint8> &src, int shade, int newColor)
+{
+	if (shade < 0)
+	{
+		// the row function doesn't handle colors being lightened past their group
+		if (newColor < 0)
+			ShaderDraw<StandardShade>(dest, src, ShaderScalar(shade));
+		else
+			ShaderDraw<ColorReplace>(dest, src, ShaderScalar(shade), ShaderScalar(newColor));
+		return;
+	}
+	helper::controler<ShaderMove<Uint8> > d(dest);
+	helper::controler<ShaderMove<Uint8> > s(src);
+
+	GraphSubset end = d.get_range();
+	s.mod_range(end);
+	if (end.size_x() == 0 || end.size_y() == 0)
+		return;
+	d.set_range(end);
+	s.set_range(end);
+
+	int begin_y = 0, end_y = end.size_y();
+	d.mod_y(begin_y, end_y);
+	s.mod_y(begin_y, end_y);
+	d.set_y(begin_y, end_y);
+	s.set_y(begin_y, end_y);
+	for (int y = end_y - begin_y; y > 0; --y, d.inc_y(), s.inc_y())
+	{
+		shadeRow(d.ptr_pos_y, s.ptr_pos_y, end.size_x(), shade, newColor);
+	}
+}
+
 /**
  * Specific blit function to blit battlescape terrain data in different shades in a fast way.
  * Notice there is no surface locking here - you have to make sure you lock the surface yourself
@@ -975,10 +1069,10 @@ void Surface::blitNShade(Surface *surface, int x, int y, int off, bool half, int
 	{
 		--newBaseColor;
 		newBaseColor <<= 4;
-		ShaderDraw<ColorReplace>(ShaderSurface(surface), src, ShaderScalar(off), ShaderScalar(newBaseColor));
+		shadeBlit(ShaderSurface(surface), src, off, newBaseColor);
 	}
 	else
-		ShaderDraw<StandardShade>(ShaderSurface(surface), src, ShaderScalar(off));
+		shadeBlit(ShaderSurface(surface), src, off, -1);
 
 }
 
@@ -997,7 +1091,7 @@ void Surface::blitNShade(Surface *surface, int x, int y, int shade, GraphSubset
 
 	dest.setDomain(range);
 
-	ShaderDraw<StandardShade>(dest, src, ShaderScalar(shade));
+	shadeBlit(dest, src, shade, -1);
 }
 
 /**
@@ -18,6 +18,8 @@
  */
 #include "SurfaceSet.h"
 #include <fstream>
+#include <iterator>
+#include <vector>
 #include "Surface.h"
 #include "Exception.h"
 
@@ -45,7 +47,7 @@ SurfaceSet::SurfaceSet(const SurfaceSet& other)
 
 	for (std::map<int, Surface*>::const_iterator f = other._frames.begin(); f != other._frames.end(); ++f)
 	{
-		_frames[f->first] = new Surface(*f->second);
+		setFrame(f->first, new Surface(*f->second));
 	}
 }
 
@@ -101,13 +103,13 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 		offsetFile.close();
 		for (int frame = 0; frame < nframes; ++frame)
 		{
-			_frames[frame] = new Surface(_width, _height);
+			setFrame(frame, new Surface(_width, _height));
 		}
 	}
 	else
 	{
 		nframes = 1;
-		_frames[0] = new Surface(_width, _height);
+		setFrame(0, new Surface(_width, _height));
 	}
 
 	// Load PCK and put pixels in surfaces
@@ -117,45 +119,45 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 		throw Exception(pck + " not found");
 	}
 
-	Uint8 value;
+	// read it all in one go and decode from memory, byte reads off the stream are slow
+	std::vector<Uint8> buffer((std::istreambuf_iterator<char>(imgFile)), (std::istreambuf_iterator<char>()));
+	imgFile.close();
 
-	for (int frame = 0; frame < nframes; ++frame)
+	size_t pos = 0, end = buffer.size();
+	for (int frame = 0; frame < nframes && pos < end; ++frame)
 	{
-		int x = 0, y = 0;
+		// surfaces start out cleared, so transparent runs only move the cursor
+		int x = 0, y = buffer[pos++];
+		Surface *surface = _frames[frame];
 
 		// Lock the surface
-		_frames[frame]->lock();
+		surface->lock();
 
-		imgFile.read((char*)&value, 1);
-		for (int i = 0; i < value; ++i)
+		while (pos < end)
 		{
-			for (int j = 0; j < _width; ++j)
+			Uint8 value = buffer[pos++];
+			if (value == 255)
 			{
-				_frames[frame]->setPixelIterative(&x, &y, 0);
+				break;
 			}
-		}
-
-		while (imgFile.read((char*)&value, 1) && value != 255)
-		{
-			if (value == 254)
+			else if (value == 254)
 			{
-				imgFile.read((char*)&value, 1);
-				for (int i = 0; i < value; ++i)
+				if (pos < end)
 				{
-					_frames[frame]->setPixelIterative(&x, &y, 0);
+					x += buffer[pos++];
+					y += x / _width;
+					x %= _width;
 				}
 			}
 			else
 			{
-				_frames[frame]->setPixelIterative(&x, &y, value);
+				surface->setPixelIterative(&x, &y, value);
 			}
 		}
 
 		// Unlock the surface
-		_frames[frame]->unlock();
+		surface->unlock();
 	}
-
-	imgFile.close();
 }
 
 /**
@@ -185,24 +187,30 @@ void SurfaceSet::loadDat(const std::string &filename)
 
 	for (int i = 0; i < nframes; ++i)
 	{
-		Surface *surface = new Surface(_width, _height);
-		_frames[i] = surface;
+		setFrame(i, new Surface(_width, _height));
+	}
+
+	std::vector<Uint8> buffer((std::istreambuf_iterator<char>(imgFile)), (std::istreambuf_iterator<char>()));
+	imgFile.close();
+	if (nframes == 0)
+	{
+		return;
 	}
 
-	Uint8 value;
 	int x = 0, y = 0, frame = 0;
+	Surface *surface = _frames[frame];
 
 	// Lock the surface
-	_frames[frame]->lock();
+	surface->lock();
 
-	while (imgFile.read((char*)&value, 1))
+	for (std::vector<Uint8>::const_iterator i = buffer.begin(); i != buffer.end(); ++i)
 	{
-		_frames[frame]->setPixelIterative(&x, &y, value);
+		surface->setPixelIterative(&x, &y, *i);
 
 		if (y >= _height)
 		{
 			// Unlock the surface
-			_frames[frame]->unlock();
+			surface->unlock();
 
 			frame++;
 			x = 0;
@@ -210,12 +218,10 @@ void SurfaceSet::loadDat(const std::string &filename)
 
 			if (frame >= nframes)
 				break;
-			else
-				_frames[frame]->lock();
+			surface = _frames[frame];
+			surface->lock();
 		}
 	}
-
-	imgFile.close();
 }
 
 /**
@@ -225,9 +231,14 @@ void SurfaceSet::loadDat(const std::string &filename)
  */
 Surface *SurfaceSet::getFrame(int i)
 {
-	if (_frames.find(i) != _frames.end())
+	if (i >= 0 && (size_t)i < _index.size())
+	{
+		return _index[i];
+	}
+	std::map<int, Surface*>::const_iterator frame = _frames.find(i);
+	if (frame != _frames.end())
 	{
-		return _frames[i];
+		return frame->second;
 	}
 	return 0;
 }
@@ -239,8 +250,31 @@ Surface *SurfaceSet::getFrame(int i)
  */
 Surface *SurfaceSet::addFrame(int i)
 {
-	_frames[i] = new Surface(_width, _height);
-	return _frames[i];
+	Surface *frame = new Surface(_width, _height);
+	setFrame(i, frame);
+	return frame;
+}
+
+/**
+ * Stores a frame in the set. Frames with small indexes are
+ * also kept in a flat table, since getFrame() is called for
+ * every sprite drawn and a map lookup there adds up.
+ * @param i Frame number in the set.
+ * @param frame Pointer to the frame surface.
+ */
+void SurfaceSet::setFrame(int i, Surface *frame)
+{
+	// sparse mod offsets go only in the map, so the table doesn't balloon
+	const int MAX_INDEXED_FRAME = 4096;
+	_frames[i] = frame;
+	if (i >= 0 && i < MAX_INDEXED_FRAME)
+	{
+		if ((size_t)i >= _index.size())
+		{
+			_index.resize(i + 1, 0);
+		}
+		_index[i] = frame;
+	}
 }
 
 /**
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <vector>
 #include <string>
 #include <SDL.h>
 
@@ -37,6 +38,10 @@ class SurfaceSet
 private:
 	int _width, _height;
 	std::map<int, Surface*> _frames;
+	std::vector<Surface*> _index;
+
+	/// Stores a frame in the set.
+	void setFrame(int i, Surface *frame);
 public:
 	/// Crates a surface set with frames of the specified size.
 	SurfaceSet(int width, int height);
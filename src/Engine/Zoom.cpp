@@ -18,6 +18,7 @@
  */
 
 #include "Zoom.h"
+#include <SDL_thread.h>
 
 #include "Surface.h"
 #include "Logger.h"
@@ -647,6 +648,9 @@ bool Zoom::haveSSE2()
 
 #endif
 
+/// Intermediate surface used when letterboxing, kept between frames.
+static SDL_Surface *letterboxSurface = 0;
+
 /**
  * Wrapper around various software and OpenGL screen buffer pushing functions which zoom.
  * Basically called just from Screen::flip()
@@ -686,7 +690,17 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
 	}
 	else
 	{
-		SDL_Surface *tmp = SDL_CreateRGBSurface(dst->flags, dstWidth, dstHeight, dst->format->BitsPerPixel, 0, 0, 0, 0);
+		// keep the intermediate surface around instead of making a new one every frame
+		SDL_Surface *&tmp = letterboxSurface;
+		if (tmp && (tmp->w != dstWidth || tmp->h != dstHeight || tmp->format->BitsPerPixel != dst->format->BitsPerPixel))
+		{
+			SDL_FreeSurface(tmp);
+			tmp = 0;
+		}
+		if (!tmp)
+		{
+			tmp = SDL_CreateRGBSurface(SDL_SWSURFACE, dstWidth, dstHeight, dst->format->BitsPerPixel, 0, 0, 0, 0);
+		}
 		_zoomSurfaceY(src, tmp, 0, 0);
 		if (src->format->palette != NULL)
 		{
@@ -694,11 +708,104 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
 		}
 		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)tmp->w, (Uint16)tmp->h};
 		SDL_BlitSurface(tmp, NULL, dst, &dstrect);
-		SDL_FreeSurface(tmp);
 	}
 }
 
 
+/// Number of horizontal bands the xBRZ scaler splits the screen into, one per thread.
+static const int XBRZ_THREADS = 4;
+
+/**
+ * Work shared with the xBRZ helper threads.
+ * The helpers wait on their semaphore for the next frame until Zoom::shutdown() stops them.
+ */
+struct XbrzJob
+{
+	size_t factor;
+	SDL_Surface *src, *dst;
+	SDL_Thread *threads[XBRZ_THREADS - 1];
+	SDL_sem *start[XBRZ_THREADS - 1];
+	SDL_sem *done;
+	bool started, threaded, quit;
+};
+static XbrzJob xbrzJob;
+
+/**
+ * Scales one band of the screen with xBRZ.
+ * xBRZ reads the rows around the band by itself, and bands never overlap in the output.
+ * @param band Index of the band, from the top.
+ */
+static void xbrzScaleBand(int band)
+{
+	int h = xbrzJob.src->h;
+	xbrz::scale(xbrzJob.factor, (uint32_t*)xbrzJob.src->pixels, (uint32_t*)xbrzJob.dst->pixels, xbrzJob.src->w, h, xbrz::RGB,
+		xbrz::ScalerCfg(), h * band / XBRZ_THREADS, h * (band + 1) / XBRZ_THREADS);
+}
+
+/**
+ * Body of an xBRZ helper thread.
+ * @param data Band index of the thread.
+ * @return Always zero.
+ */
+static int xbrzThread(void *data)
+{
+	int band = (int)(intptr_t)data;
+	for (;;)
+	{
+		SDL_SemWait(xbrzJob.start[band - 1]);
+		if (xbrzJob.quit)
+			break;
+		xbrzScaleBand(band);
+		SDL_SemPost(xbrzJob.done);
+	}
+	return 0;
+}
+
+/**
+ * Scales a surface with xBRZ, splitting the work between
+ * this thread and the helpers, which get started on first use.
+ * If the helpers can't be created, it all happens on this thread.
+ * @param factor Scaling factor.
+ * @param src The surface to zoom (input).
+ * @param dst The zoomed surface (output).
+ */
+static void xbrzScale(size_t factor, SDL_Surface *src, SDL_Surface *dst)
+{
+	if (!xbrzJob.started)
+	{
+		xbrzJob.started = true;
+		xbrzJob.done = SDL_CreateSemaphore(0);
+		xbrzJob.threaded = (xbrzJob.done != 0);
+		for (int i = 0; i < XBRZ_THREADS - 1 && xbrzJob.threaded; ++i)
+		{
+			xbrzJob.start[i] = SDL_CreateSemaphore(0);
+			xbrzJob.threads[i] = xbrzJob.start[i] ? SDL_CreateThread(xbrzThread, (void*)(intptr_t)(i + 1)) : 0;
+			xbrzJob.threaded = (xbrzJob.threads[i] != 0);
+		}
+		if (!xbrzJob.threaded)
+		{
+			Log(LOG_WARNING) << "Couldn't start the xBRZ scaler threads, scaling on the main thread.";
+		}
+	}
+	if (!xbrzJob.threaded)
+	{
+		xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
+		return;
+	}
+	xbrzJob.factor = factor;
+	xbrzJob.src = src;
+	xbrzJob.dst = dst;
+	for (int i = 0; i < XBRZ_THREADS - 1; ++i)
+	{
+		SDL_SemPost(xbrzJob.start[i]);
+	}
+	xbrzScaleBand(0);
+	for (int i = 0; i < XBRZ_THREADS - 1; ++i)
+	{
+		SDL_SemWait(xbrzJob.done);
+	}
+}
+
 /**
  * Internal 8-bit Zoomer without smoothing.
  * Source code originally from SDL_gfx (LGPL) with permission by author.
@@ -732,7 +839,7 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 			{
 				if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor)
 				{
-					xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
+					xbrzScale(factor, src, dst);
 					return 0;
 				}
 			}
@@ -931,5 +1038,41 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 }
 
 
+/**
+ * Stops the xBRZ helper threads and frees the
+ * surfaces and semaphores kept between frames.
+ * Called when the screen is torn down.
+ */
+void Zoom::shutdown()
+{
+	xbrzJob.quit = true;
+	for (int i = 0; i < XBRZ_THREADS - 1; ++i)
+	{
+		if (xbrzJob.threads[i] != 0)
+		{
+			SDL_SemPost(xbrzJob.start[i]);
+			SDL_WaitThread(xbrzJob.threads[i], 0);
+			xbrzJob.threads[i] = 0;
+		}
+		if (xbrzJob.start[i] != 0)
+		{
+			SDL_DestroySemaphore(xbrzJob.start[i]);
+			xbrzJob.start[i] = 0;
+		}
+	}
+	if (xbrzJob.done != 0)
+	{
+		SDL_DestroySemaphore(xbrzJob.done);
+		xbrzJob.done = 0;
+	}
+	xbrzJob.started = xbrzJob.threaded = xbrzJob.quit = false;
+
+	if (letterboxSurface != 0)
+	{
+		SDL_FreeSurface(letterboxSurface);
+		letterboxSurface = 0;
+	}
+}
+
 }
 
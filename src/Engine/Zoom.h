@@ -34,6 +34,8 @@ class Zoom
 	static int _zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy);
 	/// Check for SSE2 instructions using CPUID.
 	static bool haveSSE2();
+	/// Stops the scaler threads and frees cached surfaces.
+	static void shutdown();
 
 private:
 
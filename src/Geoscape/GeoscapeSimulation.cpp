@@ -0,0 +1,450 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GeoscapeSimulation.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <SDL.h>
+#include <yaml-cpp/yaml.h>
+#include "GeoscapeState.h"
+#include "UfoDetectedState.h"
+#include "MissionDetectedState.h"
+#include "AlienBaseState.h"
+#include "MonthlyReportState.h"
+#include "ResearchCompleteState.h"
+#include "../Engine/Game.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleBaseFacility.h"
+#include "../Mod/RuleCountry.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/GameTime.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/BaseFacility.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/Country.h"
+#include "../Savegame/Region.h"
+#include "../Savegame/Soldier.h"
+#include "../Savegame/SoldierDiary.h"
+#include "../Savegame/Ufo.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Gets the ID the next alien mission will get,
+ * to tell how many missions were started.
+ * @param save Pointer to the saved game.
+ * @return Next alien mission ID.
+ */
+int nextMissionId(const SavedGame *save)
+{
+	std::map<std::string, int>::const_iterator i = save->getAllIds().find("ALIEN_MISSIONS");
+	if (i != save->getAllIds().end())
+	{
+		return i->second;
+	}
+	return 1;
+}
+
+}
+
+/**
+ * Creates a simulation running a Geoscape.
+ * @param game Pointer to the core game.
+ * @param geo Pointer to the Geoscape to run.
+ */
+GeoscapeSimulation::GeoscapeSimulation(Game *game, GeoscapeState *geo) : _game(game), _geo(geo), _lastMissionId(0), _peakUfos(0), _ufosDetected(0), _missionSites(0), _alienBasesFound(0), _baseAttacks(0), _baseBattles(0), _basesLost(0), _researchCompleted(0)
+{
+	_geo->setSimulation(this);
+}
+
+/**
+ * Hands the Geoscape back to the player.
+ */
+GeoscapeSimulation::~GeoscapeSimulation()
+{
+	_geo->setSimulation(0);
+}
+
+/**
+ * Resolves a Geoscape popup the way a player that
+ * never gives any orders would, and counts the
+ * events worth keeping track of.
+ * @param state Pointer to the popup, deleted once it's resolved.
+ */
+void GeoscapeSimulation::popup(State *state)
+{
+	if (dynamic_cast<UfoDetectedState*>(state))
+	{
+		_ufosDetected++;
+	}
+	else if (dynamic_cast<MissionDetectedState*>(state))
+	{
+		_missionSites++;
+	}
+	else if (dynamic_cast<AlienBaseState*>(state))
+	{
+		_alienBasesFound++;
+	}
+	else if (dynamic_cast<ResearchCompleteState*>(state))
+	{
+		_researchCompleted++;
+	}
+	else if (MonthlyReportState *report = dynamic_cast<MonthlyReportState*>(state))
+	{
+		// the report only ends the game once it's shown
+		if (report->isGameOver())
+		{
+			_game->getSavedGame()->setEnding(END_LOSE);
+		}
+		else
+		{
+			monthlyService();
+		}
+	}
+	// everything else just waits for orders, or is an autosave or cutscene
+	delete state;
+}
+
+/**
+ * Fires the base defenses at an attacking UFO, same as
+ * BaseDefenseState without the waiting, and sorts out
+ * what happens to the base if the UFO gets through.
+ * @param base Pointer to the base under attack.
+ * @param ufo Pointer to the attacking UFO.
+ * @return True if the base was lost, which also removes the
+ * retaliation UFOs, so the Geoscape has to stop going through them.
+ */
+bool GeoscapeSimulation::baseDefense(Base *base, Ufo *ufo)
+{
+	_baseAttacks++;
+	for (int pass = 0; pass <= base->getGravShields() && ufo->getStatus() != Ufo::DESTROYED; ++pass)
+	{
+		for (std::vector<BaseFacility*>::iterator i = base->getDefenses()->begin(); i != base->getDefenses()->end() && ufo->getStatus() != Ufo::DESTROYED; ++i)
+		{
+			if (RNG::percent((*i)->getRules()->getHitRatio()))
+			{
+				int dmg = (*i)->getRules()->getDefenseValue();
+				ufo->setDamage(ufo->getDamage() + (dmg / 2 + RNG::generate(0, dmg)));
+			}
+		}
+	}
+	if (ufo->getStatus() == Ufo::DESTROYED)
+	{
+		base->cleanupDefenses(true);
+		return false;
+	}
+	else if (base->getAvailableSoldiers(true) > 0 || !base->getVehicles()->empty())
+	{
+		// nobody to fight the battle, so the base holds
+		ufo->setStatus(Ufo::DESTROYED);
+		base->cleanupDefenses(true);
+		_baseBattles++;
+		return false;
+	}
+	// the base itself is removed once the Geoscape step is done
+	_lostBases.push_back(base);
+	_geo->handleBaseDefense(base, ufo);
+	return true;
+}
+
+/**
+ * Counts another month of service for every soldier
+ * and hands out the medals they earned, same as
+ * MonthlyReportState::btnOkClick without the screens.
+ */
+void GeoscapeSimulation::monthlyService()
+{
+	SavedGame *save = _game->getSavedGame();
+	for (std::vector<Base*>::iterator b = save->getBases()->begin(); b != save->getBases()->end(); ++b)
+	{
+		for (std::vector<Soldier*>::iterator s = (*b)->getSoldiers()->begin(); s != (*b)->getSoldiers()->end(); ++s)
+		{
+			(*s)->getDiary()->addMonthlyService();
+			(*s)->getDiary()->manageCommendations(_game->getMod(), save->getMissionStatistics());
+		}
+	}
+}
+
+/**
+ * Removes the bases the aliens destroyed during
+ * the last step, same as BaseDestroyedState.
+ */
+void GeoscapeSimulation::removeLostBases()
+{
+	std::vector<Base*> *bases = _game->getSavedGame()->getBases();
+	for (std::vector<Base*>::iterator i = _lostBases.begin(); i != _lostBases.end(); ++i)
+	{
+		std::vector<Base*>::iterator j = std::find(bases->begin(), bases->end(), *i);
+		if (j != bases->end())
+		{
+			delete *j;
+			bases->erase(j);
+			_basesLost++;
+		}
+	}
+	_lostBases.clear();
+}
+
+/**
+ * Writes a line of metrics for a month.
+ * Counters cover the month so far, everything
+ * else is the state of the game right now.
+ * @param out Output stream.
+ * @param month Number of the month.
+ */
+void GeoscapeSimulation::writeMonth(std::ostream &out, int month)
+{
+	SavedGame *save = _game->getSavedGame();
+	GameTime *time = save->getTime();
+
+	int xcomScore = 0, alienScore = 0;
+	if (!save->getResearchScores().empty())
+	{
+		xcomScore += save->getResearchScores().back();
+	}
+	for (std::vector<Region*>::iterator i = save->getRegions()->begin(); i != save->getRegions()->end(); ++i)
+	{
+		xcomScore += (*i)->getActivityXcom().back();
+		alienScore += (*i)->getActivityAlien().back();
+	}
+	int pacts = 0;
+	for (std::vector<Country*>::iterator i = save->getCountries()->begin(); i != save->getCountries()->end(); ++i)
+	{
+		if ((*i)->getPact())
+		{
+			pacts++;
+		}
+	}
+	int missionId = nextMissionId(save);
+	std::string ending;
+	switch (save->getEnding())
+	{
+	case END_WIN:
+		ending = "win";
+		break;
+	case END_LOSE:
+		ending = "lose";
+		break;
+	default:
+		break;
+	}
+
+	out << month << ','
+		<< time->getYear() << '-' << std::setfill('0') << std::setw(2) << time->getMonth() << '-' << std::setw(2) << time->getDay() << std::setfill(' ') << ','
+		<< save->getFunds() << ','
+		<< save->getCountryFunding() << ','
+		<< save->getBaseMaintenance() << ','
+		<< xcomScore << ','
+		<< alienScore << ','
+		<< save->getBases()->size() << ','
+		<< save->getAlienBases()->size() << ','
+		<< missionId - _lastMissionId << ','
+		<< save->getAlienMissions().size() << ','
+		<< save->getUfos()->size() << ','
+		<< _peakUfos << ','
+		<< _ufosDetected << ','
+		<< _missionSites << ','
+		<< _alienBasesFound << ','
+		<< _baseAttacks << ','
+		<< _baseBattles << ','
+		<< _basesLost << ','
+		<< _researchCompleted << ','
+		<< save->getDiscoveredResearch().size() << ','
+		<< pacts << ','
+		<< ending << std::endl;
+}
+
+/**
+ * Clears the counters at the start of a month.
+ */
+void GeoscapeSimulation::resetMonth()
+{
+	SavedGame *save = _game->getSavedGame();
+	_lastMissionId = nextMissionId(save);
+	_peakUfos = save->getUfos()->size();
+	_ufosDetected = 0;
+	_missionSites = 0;
+	_alienBasesFound = 0;
+	_baseAttacks = 0;
+	_baseBattles = 0;
+	_basesLost = 0;
+	_researchCompleted = 0;
+}
+
+/**
+ * Runs the Geoscape as fast as it goes for a number of
+ * months, or until the game is lost, writing the metrics
+ * at the end of every month.
+ * @param months Number of months to simulate.
+ * @param metrics Full path to the CSV file for the metrics.
+ * @return True if the simulation finished.
+ */
+bool GeoscapeSimulation::run(int months, const std::string &metrics)
+{
+	std::ofstream out(metrics.c_str());
+	if (!out)
+	{
+		Log(LOG_ERROR) << "Failed to open " << metrics;
+		return false;
+	}
+	out << "month,date,funds,income,maintenance,xcomScore,alienScore,bases,alienBases,"
+		"alienMissionsStarted,alienMissionsActive,ufosActive,ufosPeak,ufosDetected,missionSites,alienBasesFound,"
+		"baseAttacks,baseBattlesSkipped,basesLost,researchCompleted,researchDiscovered,pacts,ending" << std::endl;
+
+	SavedGame *save = _game->getSavedGame();
+	_geo->startFirstMonth();
+	resetMonth();
+	Log(LOG_INFO) << "Simulating " << months << " months, seed " << RNG::getSeed();
+	Uint32 startTime = SDL_GetTicks();
+	int month = 0, days = 0;
+	bool idle = false;
+	while (month < months && save->getEnding() == END_NONE)
+	{
+		TimeTrigger trigger = save->getTime()->advance();
+		// same shortcut as GeoscapeState::timeAdvance
+		if (trigger == TIME_5SEC && idle)
+		{
+			continue;
+		}
+		if (trigger == TIME_1MONTH)
+		{
+			// the month is over before the monthly report
+			writeMonth(out, ++month);
+			Logger::flush(true);
+			if (month == months)
+			{
+				break;
+			}
+			resetMonth();
+		}
+		if (trigger >= TIME_1DAY)
+		{
+			days++;
+		}
+		_geo->timeTrigger(trigger);
+		removeLostBases();
+		_peakUfos = std::max(_peakUfos, (int)save->getUfos()->size());
+		idle = _geo->isGeoscapeIdle();
+	}
+	if (save->getEnding() != END_NONE)
+	{
+		writeMonth(out, ++month);
+		Log(LOG_INFO) << "Game lost in month " << month;
+	}
+	out.close();
+	if (!out)
+	{
+		Log(LOG_ERROR) << "Failed to write " << metrics;
+		return false;
+	}
+
+	Uint32 time = std::max<Uint32>(SDL_GetTicks() - startTime, 1);
+	Log(LOG_INFO) << "Simulated " << days << " days in " << time << " ms (" << days * 1000 / time << " days per second), metrics written to " << metrics;
+	return true;
+}
+
+/**
+ * Sets up a batch simulation from the command line options:
+ * loads the mods, loads the save or starts a new game on
+ * Beginner with the first base at the first country, and
+ * runs the Geoscape for the number of months asked for.
+ * A fixed -seed gives the same results every run.
+ * @param game Pointer to the core game.
+ * @return True if the simulation finished.
+ */
+bool GeoscapeSimulation::runBatch(Game *game)
+{
+	int months = Options::getSimulateMonths();
+	if (months <= 0)
+	{
+		Log(LOG_ERROR) << "Invalid number of months to simulate";
+		return false;
+	}
+	std::string metrics = Options::getSimulateMetrics();
+	if (metrics.empty())
+	{
+		metrics = Options::getUserFolder() + "simulation.csv";
+	}
+
+	try
+	{
+		Log(LOG_INFO) << "Loading data...";
+		Options::updateMods();
+		game->loadMods();
+		game->loadLanguages();
+
+		if (Options::getSimulateSave().empty())
+		{
+			// nobody to lay out the base either
+			Options::customInitialBase = false;
+			SavedGame *save = game->getMod()->newSave();
+			save->setDifficulty(DIFF_BEGINNER);
+			game->setSavedGame(save);
+
+			// nobody to pick a spot, so build where the first country's label is
+			RuleCountry *country = game->getMod()->getCountry(game->getMod()->getCountriesList().front(), true);
+			Base *base = save->getBases()->back();
+			base->setName("Simulation");
+			base->setLongitude(country->getLabelLongitude());
+			base->setLatitude(country->getLabelLatitude());
+			for (std::vector<Craft*>::iterator i = base->getCrafts()->begin(); i != base->getCrafts()->end(); ++i)
+			{
+				(*i)->setLongitude(base->getLongitude());
+				(*i)->setLatitude(base->getLatitude());
+			}
+		}
+		else
+		{
+			SavedGame *save = new SavedGame();
+			game->setSavedGame(save);
+			// the seed is for the simulation, not the one stored in the save
+			uint64_t seed = RNG::getSeed();
+			save->load(Options::getSimulateSave(), game->getMod());
+			RNG::setSeed(seed);
+			if (save->getSavedBattle() != 0)
+			{
+				throw Exception(Options::getSimulateSave() + " was saved in the middle of a battle");
+			}
+		}
+
+		GeoscapeState *geo = new GeoscapeState;
+		game->setState(geo);
+		GeoscapeSimulation simulation(game, geo);
+		return simulation.run(months, metrics);
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Game;
+class GeoscapeState;
+class State;
+class Base;
+class Ufo;
+
+/**
+ * Runs the Geoscape with no player and nothing drawn,
+ * for soak testing mods and timing the Geoscape logic.
+ * The commander is passive: popups are dismissed unseen,
+ * no craft are sent out and base defense battles are
+ * skipped. The state of the game is written out every
+ * month as a line of CSV metrics.
+ */
+class GeoscapeSimulation
+{
+private:
+	Game *_game;
+	GeoscapeState *_geo;
+	std::vector<Base*> _lostBases;
+	int _lastMissionId, _peakUfos, _ufosDetected, _missionSites, _alienBasesFound, _baseAttacks, _baseBattles, _basesLost, _researchCompleted;
+	/// Does the soldier bookkeeping of the monthly report.
+	void monthlyService();
+	/// Removes the bases lost since the last step.
+	void removeLostBases();
+	/// Writes the metrics for a month.
+	void writeMonth(std::ostream &out, int month);
+	/// Clears the counters for a new month.
+	void resetMonth();
+public:
+	/// Creates a simulation of a Geoscape.
+	GeoscapeSimulation(Game *game, GeoscapeState *geo);
+	/// Cleans up the simulation.
+	~GeoscapeSimulation();
+	/// Resolves a popup without showing it.
+	void popup(State *state);
+	/// Resolves an alien attack on a base.
+	bool baseDefense(Base *base, Ufo *ufo);
+	/// Runs the simulation for a number of months.
+	bool run(int months, const std::string &metrics);
+	/// Runs the simulation set up on the command line.
+	static bool runBatch(Game *game);
+};
+
+}
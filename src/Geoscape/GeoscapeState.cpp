@@ -105,6 +105,7 @@
 #include "../Mod/AlienDeployment.h"
 #include "../Mod/RuleInterface.h"
 #include "../fmath.h"
+#include "GeoscapeSimulation.h"
 
 namespace OpenXcom
 {
@@ -113,7 +114,7 @@ namespace OpenXcom
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _simulation(0)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -531,6 +532,16 @@ void GeoscapeState::init()
 	}
 	_globe->setNewBaseHover(false);
 
+	startFirstMonth();
+}
+
+/**
+ * Sets up the alien missions and pays for the first
+ * base once it's been placed in a new game.
+ * Does nothing if the game is already running.
+ */
+void GeoscapeState::startFirstMonth()
+{
 		// run once
 	if (_game->getSavedGame()->getMonthsPassed() == -1 &&
 		// as long as there's a base
@@ -657,25 +668,19 @@ void GeoscapeState::timeAdvance()
 	}
 
 
+	// a skipped trigger runs no code, so an idle geoscape stays idle
+	// until one of the longer triggers gets something moving again
+	bool idle = false;
 	for (int i = 0; i < timeSpan && !_pause; ++i)
 	{
 		TimeTrigger trigger;
 		trigger = _game->getSavedGame()->getTime()->advance();
-		switch (trigger)
+		if (trigger == TIME_5SEC && idle)
 		{
-		case TIME_1MONTH:
-			time1Month();
-		case TIME_1DAY:
-			time1Day();
-		case TIME_1HOUR:
-			time1Hour();
-		case TIME_30MIN:
-			time30Minutes();
-		case TIME_10MIN:
-			time10Minutes();
-		case TIME_5SEC:
-			time5Seconds();
+			continue;
 		}
+		timeTrigger(trigger);
+		idle = isGeoscapeIdle();
 	}
 
 	_pause = !_dogfightsToBeStarted.empty() || _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
@@ -684,6 +689,30 @@ void GeoscapeState::timeAdvance()
 	_globe->draw();
 }
 
+/**
+ * Runs the game logic for a time trigger,
+ * along with all the shorter triggers it includes.
+ * @param trigger Time trigger that was reached.
+ */
+void GeoscapeState::timeTrigger(TimeTrigger trigger)
+{
+	switch (trigger)
+	{
+	case TIME_1MONTH:
+		time1Month();
+	case TIME_1DAY:
+		time1Day();
+	case TIME_1HOUR:
+		time1Hour();
+	case TIME_30MIN:
+		time30Minutes();
+	case TIME_10MIN:
+		time10Minutes();
+	case TIME_5SEC:
+		time5Seconds();
+	}
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
@@ -697,10 +726,14 @@ void GeoscapeState::time5Seconds()
 	}
 	if (_game->getSavedGame()->getEnding() == END_LOSE)
 	{
-		_game->pushState(new CutsceneState(CutsceneState::LOSE_GAME));
-		if (_game->getSavedGame()->isIronman())
+		// a simulation just stops, there's no one to show the ending to
+		if (_simulation == 0)
 		{
-			_game->pushState(new SaveGameState(OPT_GEOSCAPE, SAVE_IRONMAN, _palette));
+			_game->pushState(new CutsceneState(CutsceneState::LOSE_GAME));
+			if (_game->getSavedGame()->isIronman())
+			{
+				_game->pushState(new SaveGameState(OPT_GEOSCAPE, SAVE_IRONMAN, _palette));
+			}
 		}
 		return;
 	}
@@ -738,7 +771,14 @@ void GeoscapeState::time5Seconds()
 					(*i)->setDestination(0);
 					base->setupDefenses();
 					timerReset();
-					if (!base->getDefenses()->empty())
+					if (_simulation != 0)
+					{
+						if (_simulation->baseDefense(base, *i))
+						{
+							return;
+						}
+					}
+					else if (!base->getDefenses()->empty())
 					{
 						popup(new BaseDefenseState(base, *i, this));
 					}
@@ -1026,6 +1066,33 @@ void GeoscapeState::time5Seconds()
 	}
 }
 
+/**
+ * Checks if there is nothing for time5Seconds() to do:
+ * no UFOs, waypoints or dogfights, and all craft idle.
+ * @return True if a 5 second trigger can be skipped.
+ */
+bool GeoscapeState::isGeoscapeIdle() const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (save->getBases()->empty() || save->getEnding() == END_LOSE ||
+		!save->getUfos()->empty() || !save->getWaypoints()->empty() ||
+		!_dogfights.empty() || !_dogfightsToBeStarted.empty())
+	{
+		return false;
+	}
+	for (std::vector<Base*>::const_iterator i = save->getBases()->begin(); i != save->getBases()->end(); ++i)
+	{
+		for (std::vector<Craft*>::const_iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
+		{
+			if (!(*j)->isIdle())
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 /**
  * Functor that attempt to detect an XCOM base.
  */
@@ -1817,10 +1884,26 @@ void GeoscapeState::timerReset()
  */
 void GeoscapeState::popup(State *state)
 {
+	if (_simulation != 0)
+	{
+		_simulation->popup(state);
+		return;
+	}
 	_pause = true;
 	_popups.push_back(state);
 }
 
+/**
+ * Sets a batch simulation to run the Geoscape without
+ * a player, which resolves the popups and base defenses
+ * instead of showing them.
+ * @param simulation Pointer to the simulation, or 0 for none.
+ */
+void GeoscapeState::setSimulation(GeoscapeSimulation *simulation)
+{
+	_simulation = simulation;
+}
+
 /**
  * Returns a pointer to the Geoscape globe for
  * access by other substates.
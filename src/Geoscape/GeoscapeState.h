@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http:///www.gnu.org/licenses/>.
  */
 #include "../Engine/State.h"
+#include "../Savegame/GameTime.h"
 #include <list>
 
 namespace OpenXcom
@@ -34,6 +35,7 @@ class Ufo;
 class MissionSite;
 class Base;
 class RuleMissionScript;
+class GeoscapeSimulation;
 
 /**
  * Geoscape screen which shows an overview of
@@ -56,6 +58,7 @@ private:
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	size_t _minimizedDogfights;
+	GeoscapeSimulation *_simulation;
 public:
 	/// Creates the Geoscape state.
 	GeoscapeState();
@@ -71,8 +74,12 @@ public:
 	void timeDisplay();
 	/// Advances the game timer.
 	void timeAdvance();
+	/// Runs the game logic for a time trigger.
+	void timeTrigger(TimeTrigger trigger);
 	/// Trigger whenever 5 seconds pass.
 	void time5Seconds();
+	/// Checks if a 5 second trigger would change anything.
+	bool isGeoscapeIdle() const;
 	/// Trigger whenever 10 minutes pass.
 	void time10Minutes();
 	/// Trigger whenever 30 minutes pass.
@@ -83,6 +90,10 @@ public:
 	void time1Day();
 	/// Trigger whenever 1 month passes.
 	void time1Month();
+	/// Starts the first month of a new game.
+	void startFirstMonth();
+	/// Hands popups and base defenses to a batch simulation.
+	void setSimulation(GeoscapeSimulation *simulation);
 	/// Resets the timer to minimum speed.
 	void timerReset();
 	/// Displays a popup window.
@@ -173,6 +173,9 @@ struct Ocean
 
 struct CreateShadow
 {
+	/// Marks cached pixels outside the globe.
+	static const Uint8 OUTSIDE_GLOBE = 255;
+
 	static inline Uint8 getShadowValue(const Cord& earth, const Cord& sun, const Sint16& noise)
 	{
 		Cord temp = earth;
@@ -221,11 +224,10 @@ struct CreateShadow
 		return Globe::OCEAN_SHADING && dest >= Globe::OCEAN_COLOR && dest < Globe::OCEAN_COLOR + 32;
 	}
 
-	static inline void func(Uint8& dest, const Cord& earth, const Cord& sun, const Sint16& noise, const int&)
+	static inline void func(Uint8& dest, const Uint8& shadow, const int&, const int&, const int&)
 	{
-		if (dest && earth.z)
+		if (dest && shadow != OUTSIDE_GLOBE)
 		{
-			const Uint8 shadow = getShadowValue(earth, sun, noise);
 			//this pixel is ocean
 			if (isOcean(dest))
 			{
@@ -244,6 +246,14 @@ struct CreateShadow
 	}
 };
 
+struct CacheShadow
+{
+	static inline void func(Uint8& shadow, const Cord& earth, const Cord& sun, const Sint16& noise, const int&)
+	{
+		shadow = earth.z ? CreateShadow::getShadowValue(earth, sun, noise) : (Uint8)CreateShadow::OUTSIDE_GLOBE;
+	}
+};
+
 }//namespace
 
 
@@ -258,7 +268,7 @@ struct CreateShadow
  * @param y Y position in pixels.
  */
 Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _cenX(cenX), _cenY(cenY), _rotLon(0.0), _rotLat(0.0), _hoverLon(0.0), _hoverLat(0.0), _craftLon(0.0), _craftLat(0.0), _craftRange(0.0), _game(game), _hover(false), _craft(false), _blink(-1),
-																					_isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _lonBeforeMouseScrolling(0.0), _latBeforeMouseScrolling(0.0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
+																					_isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _lonBeforeMouseScrolling(0.0), _latBeforeMouseScrolling(0.0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false), _shadowZoom(0), _shadowCenX(0), _shadowCenY(0)
 {
 	_rules = game->getMod()->getGlobe();
 	_texture = new SurfaceSet(*_game->getMod()->getSurfaceSet("TEXTURE.DAT"));
@@ -400,11 +410,17 @@ double Globe::lastVisibleLat(double lon) const
 Polygon* Globe::getPolygonFromLonLat(double lon, double lat) const
 {
 	const double zDiscard=0.75f;
+	// a point further than this in latitude is always discarded below,
+	// the margin keeps rounding from rejecting anything the full test would keep
+	const double latDiscard = acos(zDiscard) + 0.0001;
 	double coslat = cos(lat);
 	double sinlat = sin(lat);
 
 	for (std::list<Polygon*>::iterator i = _rules->getPolygons()->begin(); i != _rules->getPolygons()->end(); ++i)
 	{
+		if (lat - (*i)->getLatitudeMin() > latDiscard || (*i)->getLatitudeMax() - lat > latDiscard)
+			continue; //discarded
+
 		double x, y, z, x2, y2;
 		double clat, clon;
 		z = 0;
@@ -989,13 +1005,29 @@ Cord Globe::getSunDirection(double lon, double lat) const
 
 void Globe::drawShadow()
 {
-	ShaderMove<Cord> earth = ShaderMove<Cord>(_earthData[_zoom], getWidth(), getHeight());
-	ShaderRepeat<Sint16> noise = ShaderRepeat<Sint16>(_randomNoiseData, static_data.random_surf_size, static_data.random_surf_size);
+	Cord sun = getSunDirection(_cenLon, _cenLat);
+	const size_t size = getWidth() * getHeight();
+
+	// the shading only depends on the sun and where the globe sits on screen,
+	// so it's kept between redraws until one of those changes
+	if (_shadowData.size() != size || _shadowZoom != _zoom || _shadowCenX != _cenX || _shadowCenY != _cenY ||
+		_shadowSun.x != sun.x || _shadowSun.y != sun.y || _shadowSun.z != sun.z)
+	{
+		ShaderMove<Cord> earth = ShaderMove<Cord>(_earthData[_zoom], getWidth(), getHeight());
+		ShaderRepeat<Sint16> noise = ShaderRepeat<Sint16>(_randomNoiseData, static_data.random_surf_size, static_data.random_surf_size);
 
-	earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+		earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+
+		_shadowData.resize(size);
+		ShaderDraw<CacheShadow>(ShaderMove<Uint8>(_shadowData, getWidth(), getHeight()), earth, ShaderScalar(sun), noise);
+		_shadowSun = sun;
+		_shadowZoom = _zoom;
+		_shadowCenX = _cenX;
+		_shadowCenY = _cenY;
+	}
 
 	lock();
-	ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+	ShaderDraw<CreateShadow>(ShaderSurface(this), ShaderMove<Uint8>(_shadowData, getWidth(), getHeight()));
 	unlock();
 
 }
@@ -1901,6 +1933,7 @@ void Globe::setupRadii(int width, int height)
 				_earthData[r][width*j + i] = static_data.circle_norm(width/2, height/2, _zoomRadius[r], i+.5, j+.5);
 			}
 	}
+	_shadowData.clear();
 }
 
 /**
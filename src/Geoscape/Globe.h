@@ -69,6 +69,9 @@ private:
 	std::vector<std::vector<Cord> > _earthData;
 	///data sample used for noise in shading
 	std::vector<Sint16> _randomNoiseData;
+	///shading of each pixel from the last redraw, and what it was computed for
+	std::vector<Uint8> _shadowData;
+	Cord _shadowSun;
 	///list of dimension of earth on screen per zoom level
 	std::vector<double> _zoomRadius;
 
@@ -78,6 +81,8 @@ private:
 	Uint32 _mouseScrollingStartTime;
 	int _totalMouseMoveX, _totalMouseMoveY;
 	bool _mouseMovedOverThreshold;
+	size_t _shadowZoom;
+	Sint16 _shadowCenX, _shadowCenY;
 
 	/// Sets the globe zoom factor.
 	void setZoom(size_t zoom);
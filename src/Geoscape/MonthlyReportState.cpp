@@ -247,6 +247,16 @@ void MonthlyReportState::init()
 	}
 }
 
+/**
+ * Checks if the monthly rating or debts made the
+ * council end the game, once the report is shown.
+ * @return True if the game is over.
+ */
+bool MonthlyReportState::isGameOver() const
+{
+	return _gameOver;
+}
+
 /**
  * Returns to the previous screen.
  * @param action Pointer to an action.
@@ -57,6 +57,8 @@ public:
 	~MonthlyReportState();
 	/// Updates the ending.
 	void init();
+	/// Checks if the council ended the game.
+	bool isGameOver() const;
 	/// Handler for clicking the OK button.
 	void btnOkClick(Action *action);
 	/// Calculate monthly scores.
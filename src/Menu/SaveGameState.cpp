@@ -43,7 +43,7 @@ namespace OpenXcom
  * @param filename Name of the save file without extension.
  * @param palette Parent state palette.
  */
-SaveGameState::SaveGameState(OptionsOrigin origin, const std::string &filename, SDL_Color *palette) : _firstRun(0), _origin(origin), _filename(filename), _type(SAVE_DEFAULT)
+SaveGameState::SaveGameState(OptionsOrigin origin, const std::string &filename, SDL_Color *palette) : _firstRun(0), _origin(origin), _filename(filename), _type(SAVE_DEFAULT), _thread(0), _done(0)
 {
 	buildUi(palette);
 }
@@ -55,7 +55,7 @@ SaveGameState::SaveGameState(OptionsOrigin origin, const std::string &filename,
  * @param type Type of auto-save being used.
  * @param palette Parent state palette.
  */
-SaveGameState::SaveGameState(OptionsOrigin origin, SaveType type, SDL_Color *palette) : _firstRun(0), _origin(origin), _type(type)
+SaveGameState::SaveGameState(OptionsOrigin origin, SaveType type, SDL_Color *palette) : _firstRun(0), _origin(origin), _type(type), _thread(0), _done(0)
 {
 	switch (type)
 	{
@@ -84,7 +84,14 @@ SaveGameState::SaveGameState(OptionsOrigin origin, SaveType type, SDL_Color *pal
  */
 SaveGameState::~SaveGameState()
 {
-
+	if (_thread != 0)
+	{
+		SDL_WaitThread(_thread, 0);
+	}
+	if (_done != 0)
+	{
+		SDL_DestroySemaphore(_done);
+	}
 }
 
 /**
@@ -121,7 +128,9 @@ void SaveGameState::buildUi(SDL_Color *palette)
 }
 
 /**
- * Saves the current save.
+ * Saves the current save. The game state is turned into
+ * YAML right away, while the file itself is written on a
+ * separate thread so the screen keeps responding.
  */
 void SaveGameState::think()
 {
@@ -131,21 +140,12 @@ void SaveGameState::think()
 	{
 		_firstRun++;
 	}
-	else
+	else if (_firstRun == 10)
 	{
-		_game->popState();
+		_firstRun++;
 
 		switch (_type)
 		{
-		case SAVE_DEFAULT:
-			// manual save, close the save screen
-			_game->popState();
-			if (!_game->getSavedGame()->isIronman())
-			{
-				// and pause screen too
-				_game->popState();
-			}
-			break;
 		case SAVE_QUICK:
 		case SAVE_AUTO_GEOSCAPE:
 		case SAVE_AUTO_BATTLESCAPE:
@@ -155,35 +155,112 @@ void SaveGameState::think()
 			break;
 		}
 
-		// Save the game
 		try
 		{
-			std::string backup = _filename + ".bak";
-			_game->getSavedGame()->save(backup);
-			std::string fullPath = Options::getMasterUserFolder() + _filename;
-			std::string bakPath = Options::getMasterUserFolder() + backup;
-			if (!CrossPlatform::moveFile(bakPath, fullPath))
-			{
-				throw Exception("Save backed up in " + backup);
-			}
-
-			if (_type == SAVE_IRONMAN_END)
-			{
-				Screen::updateScale(Options::geoscapeScale, Options::baseXGeoscape, Options::baseYGeoscape, true);
-				_game->getScreen()->resetDisplay(false);
-
-				_game->setState(new MainMenuState);
-				_game->setSavedGame(0);
-			}
+			_game->getSavedGame()->save(_brief, _data);
 		}
 		catch (Exception &e)
 		{
-			error(e.what());
+			_error = e.what();
 		}
 		catch (YAML::Exception &e)
 		{
-			error(e.what());
+			_error = e.what();
 		}
+
+		if (!_error.empty())
+		{
+			finish();
+			return;
+		}
+
+		_done = SDL_CreateSemaphore(0);
+		if (_done != 0)
+		{
+			_thread = SDL_CreateThread(write, (void*)this);
+		}
+		if (_thread == 0)
+		{
+			// no threads, write it right here
+			write((void*)this);
+			finish();
+		}
+	}
+	else if (SDL_SemTryWait(_done) == 0)
+	{
+		SDL_WaitThread(_thread, 0);
+		_thread = 0;
+		finish();
+	}
+}
+
+/**
+ * Writes the saved game documents to a backup file,
+ * then replaces the actual save with it.
+ * @param state_ptr Pointer to the save state.
+ * @return Always zero.
+ */
+int SaveGameState::write(void *state_ptr)
+{
+	SaveGameState *state = (SaveGameState*)state_ptr;
+	try
+	{
+		std::string backup = state->_filename + ".bak";
+		SavedGame::write(backup, state->_brief, state->_data);
+		std::string fullPath = Options::getMasterUserFolder() + state->_filename;
+		std::string bakPath = Options::getMasterUserFolder() + backup;
+		if (!CrossPlatform::moveFile(bakPath, fullPath))
+		{
+			throw Exception("Save backed up in " + backup);
+		}
+	}
+	catch (Exception &e)
+	{
+		state->_error = e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		state->_error = e.what();
+	}
+	if (state->_done != 0)
+	{
+		SDL_SemPost(state->_done);
+	}
+	return 0;
+}
+
+/**
+ * Closes the save screens once the save is done,
+ * reporting any error that came up.
+ */
+void SaveGameState::finish()
+{
+	// the list cache isn't touched by the writer thread, so it's updated here
+	SavedGame::forgetSaveInfo(_filename);
+
+	_game->popState();
+	if (_type == SAVE_DEFAULT)
+	{
+		// manual save, close the save screen
+		_game->popState();
+		if (!_game->getSavedGame()->isIronman())
+		{
+			// and pause screen too
+			_game->popState();
+		}
+	}
+
+	if (!_error.empty())
+	{
+		error(_error);
+	}
+	else if (_type == SAVE_IRONMAN_END)
+	{
+		Screen::updateScale(Options::geoscapeScale, Options::baseXGeoscape, Options::baseYGeoscape, true);
+		_game->getScreen()->resetDisplay(false);
+
+		_game->setState(new MainMenuState);
+		_game->setSavedGame(0);
 	}
 }
 
@@ -19,7 +19,9 @@
  */
 #include "../Engine/State.h"
 #include <SDL.h>
+#include <SDL_thread.h>
 #include <string>
+#include <yaml-cpp/yaml.h>
 #include "OptionsBaseState.h"
 #include "../Savegame/SavedGame.h"
 
@@ -39,6 +41,15 @@ private:
 	Text *_txtStatus;
 	std::string _filename;
 	SaveType _type;
+	YAML::Node _brief, _data;
+	std::string _error;
+	SDL_Thread *_thread;
+	SDL_sem *_done;
+
+	/// Writes the save file in the background.
+	static int write(void *state_ptr);
+	/// Finishes up after the save file is written.
+	void finish();
 public:
 	/// Creates the Save Game state.
 	SaveGameState(OptionsOrigin origin, const std::string &filename, SDL_Color *palette);
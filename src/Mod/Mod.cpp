@@ -67,6 +67,7 @@
 #include "ExtraStrings.h"
 #include "RuleInterface.h"
 #include "RuleMissionScript.h"
+#include "RulesetCache.h"
 #include "../Geoscape/Globe.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/Region.h"
@@ -383,7 +384,7 @@ Mod::~Mod()
  * @return Pointer to the rule element, or NULL if not found.
  */
 template <typename T>
-T *Mod::getRule(const std::string &id, const std::string &name, const std::map<std::string, T*> &map, bool error) const
+T *Mod::getRule(const std::string &id, const char *name, const std::map<std::string, T*> &map, bool error) const
 {
 	if (id.empty())
 	{
@@ -398,7 +399,7 @@ T *Mod::getRule(const std::string &id, const std::string &name, const std::map<s
 	{
 		if (error)
 		{
-			throw Exception(name + " " + id + " not found");
+			throw Exception(std::string(name) + " " + id + " not found");
 		}
 		return 0;
 	}
@@ -423,6 +424,7 @@ void Mod::lazyLoadSurface(const std::string &name)
 {
 	if (Options::lazyLoadResources)
 	{
+		loadLazySurface(name);
 		std::map<std::string, std::vector<ExtraSprites *> >::const_iterator i = _extraSprites.find(name);
 		if (i != _extraSprites.end())
 		{
@@ -434,6 +436,40 @@ void Mod::lazyLoadSurface(const std::string &name)
 	}
 }
 
+/**
+ * Decodes a deferred vanilla background the first time
+ * it's needed, so startup doesn't pay for screens that
+ * are never opened.
+ * @param name Surface name.
+ */
+void Mod::loadLazySurface(const std::string &name)
+{
+	std::map<std::string, std::string>::iterator i = _lazySurfaces.find(name);
+	if (i == _lazySurfaces.end())
+		return;
+
+	Surface *surface = new Surface(320, 200);
+	std::string path = FileMap::getFilePath(i->second);
+	if (CrossPlatform::compareExt(i->second, "SCR"))
+	{
+		surface->loadScr(path);
+	}
+	else if (CrossPlatform::compareExt(i->second, "BDY"))
+	{
+		surface->loadBdy(path);
+	}
+	else
+	{
+		surface->loadSpk(path);
+	}
+	if (_statePalette)
+	{
+		surface->setPalette(_statePalette);
+	}
+	_surfaces[name] = surface;
+	_lazySurfaces.erase(i);
+}
+
 /**
  * Returns a specific surface from the mod.
  * @param name Name of the surface.
@@ -709,6 +745,7 @@ int Mod::getOffset(int id, int max) const
 void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::string> > > &mods)
 {
 	Log(LOG_INFO) << "Loading rulesets...";
+	Uint32 startTime = SDL_GetTicks();
 	std::vector<size_t> modOffsets(mods.size());
 	size_t offset = 0;
 	for (size_t i = 0; mods.size() > i; ++i)
@@ -724,11 +761,15 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 			offset += 1;
 		}
 	}
+	RulesetCache cache(Options::getUserFolder() + "rulesets.cache", mods);
+	cache.load();
 	for (size_t i = 0; mods.size() > i; ++i)
 	{
 		try
 		{
-			loadMod(mods[i].second, modOffsets[i]);
+			Uint32 modStartTime = SDL_GetTicks();
+			loadMod(mods[i].second, modOffsets[i], &cache);
+			Log(LOG_VERBOSE) << "Loaded rulesets of '" << mods[i].first << "' in " << (SDL_GetTicks() - modStartTime) << " ms";
 		}
 		catch (Exception &e)
 		{
@@ -763,9 +804,13 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 			throw Exception(ss.str());
 		}
 	}
+	cache.save();
 	sortLists();
+	Log(LOG_INFO) << "Rulesets loaded in " << (SDL_GetTicks() - startTime) << " ms";
+	Uint32 resourceTime = SDL_GetTicks();
 	loadExtraResources();
 	modResources();
+	Log(LOG_INFO) << "Extra resources loaded in " << (SDL_GetTicks() - resourceTime) << " ms";
 }
 
 /**
@@ -773,8 +818,9 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
  * mod loaded should be the master at index 0, then 1, and so on.
  * @param rulesetFiles List of rulesets to load.
  * @param modIdx Mod index number.
+ * @param cache Cache of parsed rulesets.
  */
-void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx)
+void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx, RulesetCache *cache)
 {
 	_modOffset = 1000 * modIdx;
 
@@ -783,7 +829,7 @@ void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx)
 		Log(LOG_VERBOSE) << "- " << *i;
 		try
 		{
-			loadFile(*i);
+			loadFile(cache->getRuleset(*i));
 		}
 		catch (YAML::Exception &e)
 		{
@@ -850,19 +896,19 @@ void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx)
 
 	if (modIdx == 0)
 	{
+		Uint32 startTime = SDL_GetTicks();
 		loadVanillaResources();
+		Log(LOG_INFO) << "Vanilla resources loaded in " << (SDL_GetTicks() - startTime) << " ms";
 	}
 }
 
 /**
- * Loads a ruleset's contents from a YAML file.
+ * Loads a ruleset's contents from a YAML document.
  * Rules that match pre-existing rules overwrite them.
- * @param filename YAML filename.
+ * @param doc YAML document of a ruleset file.
  */
-void Mod::loadFile(const std::string &filename)
+void Mod::loadFile(const YAML::Node &doc)
 {
-	YAML::Node doc = YAML::LoadFile(filename);
-
 	for (YAML::const_iterator i = doc["countries"].begin(); i != doc["countries"].end(); ++i)
 	{
 		RuleCountry *rule = loadRule(*i, &_countries, &_countriesIndex);
@@ -2581,31 +2627,22 @@ void Mod::loadVanillaResources()
 		_surfaces[s2]->loadScr(FileMap::getFilePath(s1));
 	}
 
+	// with lazy loading, backgrounds are only decoded when a screen asks for them
 	const std::set<std::string> &geographFiles(FileMap::getVFolderContents("GEOGRAPH"));
-	std::set<std::string> scrs = FileMap::filterFiles(geographFiles, "SCR");
-	for (std::set<std::string>::iterator i = scrs.begin(); i != scrs.end(); ++i)
+	std::string backgrounds[] = { "SCR", "BDY", "SPK" };
+	for (size_t i = 0; i < ARRAYLEN(backgrounds); ++i)
 	{
-		std::string fname = *i;
-		std::transform(i->begin(), i->end(), fname.begin(), toupper);
-		_surfaces[fname] = new Surface(320, 200);
-		_surfaces[fname]->loadScr(FileMap::getFilePath("GEOGRAPH/" + fname));
-	}
-	std::set<std::string> bdys = FileMap::filterFiles(geographFiles, "BDY");
-	for (std::set<std::string>::iterator i = bdys.begin(); i != bdys.end(); ++i)
-	{
-		std::string fname = *i;
-		std::transform(i->begin(), i->end(), fname.begin(), toupper);
-		_surfaces[fname] = new Surface(320, 200);
-		_surfaces[fname]->loadBdy(FileMap::getFilePath("GEOGRAPH/" + fname));
-	}
-
-	std::set<std::string> spks = FileMap::filterFiles(geographFiles, "SPK");
-	for (std::set<std::string>::iterator i = spks.begin(); i != spks.end(); ++i)
-	{
-		std::string fname = *i;
-		std::transform(i->begin(), i->end(), fname.begin(), toupper);
-		_surfaces[fname] = new Surface(320, 200);
-		_surfaces[fname]->loadSpk(FileMap::getFilePath("GEOGRAPH/" + fname));
+		std::set<std::string> files = FileMap::filterFiles(geographFiles, backgrounds[i]);
+		for (std::set<std::string>::iterator j = files.begin(); j != files.end(); ++j)
+		{
+			std::string fname = *j;
+			std::transform(j->begin(), j->end(), fname.begin(), toupper);
+			_lazySurfaces[fname] = "GEOGRAPH/" + fname;
+			if (!Options::lazyLoadResources)
+			{
+				loadLazySurface(fname);
+			}
+		}
 	}
 
 	// Load surface sets
@@ -78,6 +78,7 @@ class MapScript;
 class RuleVideo;
 class RuleMusic;
 class RuleMissionScript;
+class RulesetCache;
 struct StatAdjustment;
 
 /**
@@ -94,6 +95,7 @@ private:
 	std::map<std::string, Palette*> _palettes;
 	std::map<std::string, Font*> _fonts;
 	std::map<std::string, Surface*> _surfaces;
+	std::map<std::string, std::string> _lazySurfaces;
 	std::map<std::string, SurfaceSet*> _sets;
 	std::map<std::string, SoundSet*> _sounds;
 	std::map<std::string, Music*> _musics;
@@ -152,14 +154,14 @@ private:
 	SDL_Color *_statePalette;
 	std::vector<std::string> _psiRequirements; // it's a cache for psiStrengthEval
 
-	/// Loads a ruleset from a YAML file.
-	void loadFile(const std::string &filename);
+	/// Loads a ruleset from a YAML document.
+	void loadFile(const YAML::Node &doc);
 	/// Loads a ruleset element.
 	template <typename T>
 	T *loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::vector<std::string> *index = 0, const std::string &key = "type") const;
 	/// Gets a ruleset element.
 	template <typename T>
-	T *getRule(const std::string &id, const std::string &name, const std::map<std::string, T*> &map, bool error) const;
+	T *getRule(const std::string &id, const char *name, const std::map<std::string, T*> &map, bool error) const;
 	/// Gets a random music. This is private to prevent access, use playMusic(name, true) instead.
 	Music *getRandomMusic(const std::string &name) const;
 	/// Gets a particular sound set. This is private to prevent access, use getSound(name, id) instead.
@@ -171,13 +173,15 @@ private:
 	/// Creates a transparency lookup table for a given palette.
 	void createTransparencyLUT(Palette *pal);
 	/// Loads a specified mod content.
-	void loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx);
+	void loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx, RulesetCache *cache);
 	/// Loads resources from vanilla.
 	void loadVanillaResources();
 	/// Loads resources from extra rulesets.
 	void loadExtraResources();
 	/// Loads surfaces on demand.
 	void lazyLoadSurface(const std::string &name);
+	/// Decodes a deferred vanilla background.
+	void loadLazySurface(const std::string &name);
 	/// Loads an external sprite.
 	void loadExtraSprite(ExtraSprites *spritePack);
 	/// Applies mods to vanilla resources.
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Polygon.h"
+#include <algorithm>
 #include "../fmath.h"
 
 namespace OpenXcom
@@ -26,7 +27,7 @@ namespace OpenXcom
  * Initializes the polygon with arrays to store each point's coordinates.
  * @param points Number of points.
  */
-Polygon::Polygon(int points) : _points(points), _texture(0)
+Polygon::Polygon(int points) : _latMin(0.0), _latMax(0.0), _points(points), _texture(0)
 {
 	_lat = new double[_points];
 	_lon = new double[_points];
@@ -59,6 +60,8 @@ Polygon::Polygon(const Polygon& other)
 		_x[i] = other._x[i];
 		_y[i] = other._y[i];
 	}
+	_latMin = other._latMin;
+	_latMax = other._latMax;
 	_texture = other._texture;
 }
 
@@ -100,6 +103,22 @@ void Polygon::load(const YAML::Node &node)
 		_x[j] = 0;
 		_y[j] = 0;
 	}
+	updateLatitudeRange();
+}
+
+/**
+ * Recalculates the range of latitudes covered by
+ * the polygon's points, used to quickly rule it out
+ * in point lookups.
+ */
+void Polygon::updateLatitudeRange()
+{
+	_latMin = _latMax = (_points > 0) ? _lat[0] : 0.0;
+	for (int i = 1; i < _points; ++i)
+	{
+		_latMin = std::min(_latMin, _lat[i]);
+		_latMax = std::max(_latMax, _lat[i]);
+	}
 }
 
 /**
@@ -120,6 +139,7 @@ double Polygon::getLatitude(int i) const
 void Polygon::setLatitude(int i, double lat)
 {
 	_lat[i] = lat;
+	updateLatitudeRange();
 }
 
 /**
@@ -142,6 +162,24 @@ void Polygon::setLongitude(int i, double lon)
 	_lon[i] = lon;
 }
 
+/**
+ * Returns the lowest latitude of any of the polygon's points.
+ * @return Latitude in radians.
+ */
+double Polygon::getLatitudeMin() const
+{
+	return _latMin;
+}
+
+/**
+ * Returns the highest latitude of any of the polygon's points.
+ * @return Latitude in radians.
+ */
+double Polygon::getLatitudeMax() const
+{
+	return _latMax;
+}
+
 /**
  * Returns the X coordinate of a given point.
  * @param i Point number (0-max).
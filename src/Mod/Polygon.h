@@ -32,8 +32,12 @@ class Polygon
 {
 private:
 	double *_lat, *_lon;
+	double _latMin, _latMax;
 	Sint16 *_x, *_y;
 	int _points, _texture;
+
+	/// Recalculates the latitude range of the points.
+	void updateLatitudeRange();
 public:
 	/// Creates a polygon with a number of points.
 	Polygon(int points);
@@ -51,6 +55,10 @@ public:
 	double getLongitude(int i) const;
 	/// Sets the longitude of a point.
 	void setLongitude(int i, double lon);
+	/// Gets the southernmost latitude of the polygon.
+	double getLatitudeMin() const;
+	/// Gets the northernmost latitude of the polygon.
+	double getLatitudeMax() const;
 	/// Gets the X coordinate of a point.
 	Sint16 getX(int i) const;
 	/// Sets the X coordinate of a point.
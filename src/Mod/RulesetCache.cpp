@@ -0,0 +1,262 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RulesetCache.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <SDL.h>
+#include "../version.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Marks the start of a ruleset cache file.
+const char CACHE_MAGIC[4] = {'O', 'X', 'R', 'C'};
+/// Version of the cache layout, bumped whenever it changes.
+const Uint8 CACHE_VERSION = 1;
+/// Magic, version, key, number of files and YAML parse time.
+const size_t CACHE_HEADER_SIZE = 21;
+
+/**
+ * Adds some bytes to a 64-bit FNV-1a hash.
+ * @param hash Hash so far.
+ * @param data Pointer to the bytes.
+ * @param size Number of bytes.
+ */
+void hashBytes(Uint64 &hash, const void *data, size_t size)
+{
+	const Uint8 *bytes = (const Uint8*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+}
+
+/**
+ * Adds a string to a hash, terminator included
+ * so consecutive strings can't run together.
+ * @param hash Hash so far.
+ * @param s String to add.
+ */
+void hashString(Uint64 &hash, const std::string &s)
+{
+	hashBytes(hash, s.c_str(), s.size() + 1);
+}
+
+void writeNumber(Uint8 *buffer, Uint64 value, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+	{
+		buffer[i] = (Uint8)(value >> (i * 8));
+	}
+}
+
+Uint64 readNumber(const Uint8 *buffer, int bytes)
+{
+	Uint64 value = 0;
+	for (int i = 0; i < bytes; ++i)
+	{
+		value |= (Uint64)buffer[i] << (i * 8);
+	}
+	return value;
+}
+
+/**
+ * Adds a number to a hash, in a fixed byte order.
+ * @param hash Hash so far.
+ * @param value Number to add.
+ */
+void hashNumber(Uint64 &hash, Uint64 value)
+{
+	Uint8 bytes[8];
+	writeNumber(bytes, value, 8);
+	hashBytes(hash, bytes, 8);
+}
+
+}
+
+/**
+ * Creates a ruleset cache for a list of mods. The cache key
+ * covers the game version, the mods in load order and the
+ * path, date and size of each of their ruleset files, so
+ * changing any of them makes the cache stale.
+ * @param path Full path to the cache file.
+ * @param mods List of <modId, rulesetFiles> pairs.
+ */
+RulesetCache::RulesetCache(const std::string &path, const std::vector< std::pair< std::string, std::vector<std::string> > > &mods) : _path(path), _key(14695981039346656037ULL), _files(0), _parseTime(0), _enabled(Options::rulesetCache), _loaded(false)
+{
+	if (!_enabled)
+	{
+		return;
+	}
+	hashNumber(_key, CACHE_VERSION);
+	hashString(_key, OPENXCOM_VERSION_SHORT OPENXCOM_VERSION_GIT);
+	for (std::vector< std::pair< std::string, std::vector<std::string> > >::const_iterator i = mods.begin(); i != mods.end(); ++i)
+	{
+		hashString(_key, i->first);
+		hashNumber(_key, i->second.size());
+		for (std::vector<std::string>::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+		{
+			hashString(_key, *j);
+			hashNumber(_key, CrossPlatform::getDateModified(*j));
+			hashNumber(_key, CrossPlatform::getFileSize(*j));
+		}
+	}
+}
+
+/**
+ * Cleans up the ruleset cache.
+ */
+RulesetCache::~RulesetCache()
+{
+}
+
+/**
+ * Loads all the rulesets from the cache file, if it was
+ * made for the same mods. A missing, stale or broken
+ * cache just means the rulesets get parsed as usual.
+ * @return True if the cache was loaded.
+ */
+bool RulesetCache::load()
+{
+	if (!_enabled)
+	{
+		return false;
+	}
+	Uint32 startTime = SDL_GetTicks();
+	std::ifstream file(_path.c_str(), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	std::vector<Uint8> data((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
+	file.close();
+	if (data.size() < CACHE_HEADER_SIZE ||
+		!std::equal(CACHE_MAGIC, CACHE_MAGIC + 4, (const char*)&data[0]) ||
+		data[4] != CACHE_VERSION ||
+		readNumber(&data[5], 8) != _key)
+	{
+		Log(LOG_INFO) << "Ruleset cache is out of date, parsing rulesets";
+		return false;
+	}
+	size_t files = readNumber(&data[13], 4);
+	Uint32 parseTime = readNumber(&data[17], 4);
+
+	std::map<std::string, YAML::Node> docs;
+	try
+	{
+		BinaryYamlReader reader(&data[0] + CACHE_HEADER_SIZE, data.size() - CACHE_HEADER_SIZE);
+		while (!reader.atEnd())
+		{
+			size_t size = reader.readSize();
+			std::string filename((const char*)reader.readBytes(size), size);
+			docs[filename] = reader.readNode();
+		}
+		if (docs.size() != files)
+		{
+			throw Exception("Ruleset files are missing");
+		}
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_WARNING) << "Ruleset cache " << _path << " is broken, parsing rulesets: " << e.what();
+		return false;
+	}
+	_docs.swap(docs);
+	_loaded = true;
+	Log(LOG_INFO) << "Rulesets read from cache in " << (SDL_GetTicks() - startTime) << " ms, parsing them took " << parseTime << " ms";
+	return true;
+}
+
+/**
+ * Gets the contents of a ruleset file, from the cache if
+ * it's there, otherwise by parsing the file and keeping
+ * the result for the cache.
+ * @param filename Full path to the ruleset file.
+ * @return YAML node for the ruleset.
+ */
+YAML::Node RulesetCache::getRuleset(const std::string &filename)
+{
+	std::map<std::string, YAML::Node>::iterator i = _docs.find(filename);
+	if (i != _docs.end())
+	{
+		// each file is only loaded once, no need to keep it around
+		YAML::Node doc = i->second;
+		_docs.erase(i);
+		return doc;
+	}
+
+	Uint32 startTime = SDL_GetTicks();
+	YAML::Node doc = YAML::LoadFile(filename);
+	_parseTime += SDL_GetTicks() - startTime;
+	if (!_enabled)
+	{
+		return doc;
+	}
+	_writer.writeSize(filename.size());
+	_writer.writeBytes(filename.data(), filename.size());
+	_writer.writeNode(doc);
+	_files++;
+	return doc;
+}
+
+/**
+ * Saves the parsed rulesets to the cache file, to be
+ * used on the next start. Should only be called once
+ * all the rulesets loaded without errors.
+ */
+void RulesetCache::save()
+{
+	if (!_enabled || _loaded)
+	{
+		return;
+	}
+	Uint8 header[CACHE_HEADER_SIZE];
+	std::copy(CACHE_MAGIC, CACHE_MAGIC + 4, (char*)header);
+	header[4] = CACHE_VERSION;
+	writeNumber(header + 5, _key, 8);
+	writeNumber(header + 13, _files, 4);
+	writeNumber(header + 17, _parseTime, 4);
+
+	std::ofstream file(_path.c_str(), std::ios::binary);
+	file.write((const char*)header, CACHE_HEADER_SIZE);
+	const std::vector<Uint8> &data = _writer.getData();
+	if (!data.empty())
+	{
+		file.write((const char*)&data[0], data.size());
+	}
+	file.close();
+	if (!file)
+	{
+		Log(LOG_WARNING) << "Failed to save ruleset cache " << _path;
+		CrossPlatform::deleteFile(_path);
+		return;
+	}
+	Log(LOG_INFO) << "Rulesets parsed in " << _parseTime << " ms, saved to cache for the next start";
+}
+
+}
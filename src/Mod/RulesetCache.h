@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include <yaml-cpp/yaml.h>
+#include "../Engine/BinaryYaml.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Keeps the parsed ruleset files of the loaded mods in a
+ * binary file, so the next start doesn't have to parse
+ * all the YAML again. The cache only matches the exact
+ * same mod list with the same files, dates and sizes,
+ * anything else falls back to parsing the rulesets.
+ * Turned off with the rulesetCache option.
+ */
+class RulesetCache
+{
+private:
+	std::string _path;
+	Uint64 _key;
+	std::map<std::string, YAML::Node> _docs;
+	BinaryYamlWriter _writer;
+	Uint32 _files, _parseTime;
+	bool _enabled, _loaded;
+public:
+	/// Creates a ruleset cache for a list of mods.
+	RulesetCache(const std::string &path, const std::vector< std::pair< std::string, std::vector<std::string> > > &mods);
+	/// Cleans up the ruleset cache.
+	~RulesetCache();
+	/// Loads the cache file if it matches the mods.
+	bool load();
+	/// Gets the contents of a ruleset file.
+	YAML::Node getRuleset(const std::string &filename);
+	/// Saves the parsed rulesets to the cache file.
+	void save();
+};
+
+}
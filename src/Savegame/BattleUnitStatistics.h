@@ -100,6 +100,8 @@ struct BattleUnitKills
 		node["side"] = (int)side;
 		node["bodypart"] = (int)bodypart;
 		node["id"] = id;
+		// kill lists grow with every mission, keep each kill on one line
+		node.SetStyle(YAML::EmitterStyle::Flow);
 		return node;
 	}
 
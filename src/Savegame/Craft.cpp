@@ -888,6 +888,16 @@ bool Craft::isDestroyed() const
 	return (_damage >= _rules->getMaxDamage());
 }
 
+/**
+ * Checks if the craft has no destination and is not
+ * taking off, so moving it wouldn't change anything.
+ * @return Is the craft idle?
+ */
+bool Craft::isIdle() const
+{
+	return (_dest == 0 && _takeoff == 0 && !isDestroyed());
+}
+
 /**
  * Returns the amount of space available for
  * soldiers and vehicles.
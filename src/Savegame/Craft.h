@@ -159,6 +159,8 @@ public:
 	bool isInBattlescape() const;
 	/// Gets if craft is destroyed during dogfights.
 	bool isDestroyed() const;
+	/// Checks if the craft has nothing to do on the geoscape.
+	bool isIdle() const;
 	/// Gets the amount of space available inside a craft.
 	int getSpaceAvailable() const;
 	/// Gets the amount of space used inside a craft.
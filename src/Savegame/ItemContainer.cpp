@@ -68,10 +68,7 @@ void ItemContainer::addItem(const std::string &id, int qty)
 	{
 		return;
 	}
-	if (_qty.find(id) == _qty.end())
-	{
-		_qty[id] = 0;
-	}
+	// operator[] starts new entries at zero
 	_qty[id] += qty;
 }
 
@@ -82,17 +79,22 @@ void ItemContainer::addItem(const std::string &id, int qty)
  */
 void ItemContainer::removeItem(const std::string &id, int qty)
 {
-	if (id.empty() || _qty.find(id) == _qty.end())
+	if (id.empty())
+	{
+		return;
+	}
+	std::map<std::string, int>::iterator it = _qty.find(id);
+	if (it == _qty.end())
 	{
 		return;
 	}
-	if (qty < _qty[id])
+	if (qty < it->second)
 	{
-		_qty[id] -= qty;
+		it->second -= qty;
 	}
 	else
 	{
-		_qty.erase(id);
+		_qty.erase(it);
 	}
 }
 
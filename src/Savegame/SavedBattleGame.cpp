@@ -18,6 +18,7 @@
  */
 #include <assert.h>
 #include <vector>
+#include <new>
 #include "BattleItem.h"
 #include "SavedBattleGame.h"
 #include "SavedGame.h"
@@ -47,7 +48,7 @@ namespace OpenXcom
 /**
  * Initializes a brand new battlescape saved game.
  */
-SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0), _lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
+SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _tiles(0), _selectedUnit(0), _lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
 	_side(FACTION_PLAYER), _turn(1), _debugMode(false), _aborted(false), _itemId(0), _objectiveType(-1), _objectivesDestroyed(0), _objectivesNeeded(0), _unitsFalling(false), _cheating(false),
 	_tuReserved(BA_NONE), _kneelReserved(false), _depth(0), _ambience(-1), _ambientVolume(0.5), _turnLimit(0), _cheatTurn(20), _chronoTrigger(FORCE_LOSE), _beforeGame(true)
 {
@@ -64,14 +65,7 @@ SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(
  */
 SavedBattleGame::~SavedBattleGame()
 {
-	if (_mapsize_z * _mapsize_y * _mapsize_x > 0)
-	{
-		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
-		{
-			delete _tiles[i];
-		}
-		delete[] _tiles;
-	}
+	freeTiles();
 
 	for (std::vector<MapDataSet*>::iterator i = _mapDataSets.begin(); i != _mapDataSets.end(); ++i)
 	{
@@ -169,7 +163,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 		{
 			int index = unserializeInt(&r, serKey.index);
 			assert (index >= 0 && index < _mapsize_x * _mapsize_z * _mapsize_y);
-			_tiles[index]->loadBinary(r, serKey); // loadBinary's privileges to advance *r have been revoked
+			_tiles[index].loadBinary(r, serKey); // loadBinary's privileges to advance *r have been revoked
 			r += serKey.totalBytes-serKey.index; // r is now incremented strictly by totalBytes in case there are obsolete fields present in the data
 		}
 	}
@@ -358,10 +352,10 @@ void SavedBattleGame::loadMapResources(Mod *mod)
 		for (int part = O_FLOOR; part <= O_OBJECT; part++)
 		{
 			TilePart tp = (TilePart) part;
-			_tiles[i]->getMapData(&mdID, &mdsID, tp);
+			_tiles[i].getMapData(&mdID, &mdsID, tp);
 			if (mdID != -1 && mdsID != -1)
 			{
-				_tiles[i]->setMapData(_mapDataSets[mdsID]->getObjects()->at(mdID), mdID, mdsID, tp);
+				_tiles[i].setMapData(_mapDataSets[mdsID]->getObjects()->at(mdID), mdID, mdsID, tp);
 			}
 		}
 	}
@@ -400,9 +394,9 @@ YAML::Node SavedBattleGame::save() const
 #if 0
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
-		if (!_tiles[i]->isVoid())
+		if (!_tiles[i].isVoid())
 		{
-			node["tiles"].push_back(_tiles[i]->save());
+			node["tiles"].push_back(_tiles[i].save());
 		}
 	}
 #else
@@ -421,10 +415,10 @@ YAML::Node SavedBattleGame::save() const
 
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
-		if (!_tiles[i]->isVoid())
+		if (!_tiles[i].isVoid())
 		{
 			serializeInt(&w, Tile::serializationKey.index, i);
-			_tiles[i]->saveBinary(&w);
+			_tiles[i].saveBinary(&w);
 		}
 		else
 		{
@@ -473,12 +467,19 @@ YAML::Node SavedBattleGame::save() const
 }
 
 /**
- * Gets the array of tiles.
- * @return A pointer to the Tile array.
+ * Destroys all the tiles of the map and releases their storage.
  */
-Tile **SavedBattleGame::getTiles() const
+void SavedBattleGame::freeTiles()
 {
-	return _tiles;
+	if (_mapsize_z * _mapsize_y * _mapsize_x > 0)
+	{
+		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
+		{
+			_tiles[i].~Tile();
+		}
+		::operator delete(_tiles);
+	}
+	_tiles = 0;
 }
 
 /**
@@ -490,14 +491,7 @@ Tile **SavedBattleGame::getTiles() const
 void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool resetTerrain)
 {
 	// Clear old map data
-	if (_mapsize_z * _mapsize_y * _mapsize_x > 0)
-	{
-		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
-		{
-			delete _tiles[i];
-		}
-		delete[] _tiles;
-	}
+	freeTiles();
 
 	for (std::vector<Node*>::iterator i = _nodes.begin(); i != _nodes.end(); ++i)
 	{
@@ -514,12 +508,13 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	_mapsize_x = mapsize_x;
 	_mapsize_y = mapsize_y;
 	_mapsize_z = mapsize_z;
-	_tiles = new Tile*[_mapsize_z * _mapsize_y * _mapsize_x];
+	// all tiles live in one block, in index order, so whole-map sweeps walk memory linearly
+	_tiles = static_cast<Tile*>(::operator new(sizeof(Tile) * _mapsize_z * _mapsize_y * _mapsize_x));
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
 		Position pos;
 		getTileCoords(i, &pos.x, &pos.y, &pos.z);
-		_tiles[i] = new Tile(pos);
+		new (&_tiles[i]) Tile(pos);
 	}
 
 }
@@ -917,7 +912,7 @@ void SavedBattleGame::setDebugMode()
 {
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
-		_tiles[i]->setDiscovered(true, 2);
+		_tiles[i].setDiscovered(true, 2);
 	}
 
 	_debugMode = true;
@@ -1083,11 +1078,11 @@ void SavedBattleGame::removeItem(BattleItem *item)
 	/*
 	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 	{
-		for (std::vector<BattleItem*>::iterator it = _tiles[i]->getInventory()->begin(); it != _tiles[i]->getInventory()->end(); )
+		for (std::vector<BattleItem*>::iterator it = _tiles[i].getInventory()->begin(); it != _tiles[i].getInventory()->end(); )
 		{
 			if ((*it) == item)
 			{
-				it = _tiles[i]->getInventory()->erase(it);
+				it = _tiles[i].getInventory()->erase(it);
 				return;
 			}
 			++it;
@@ -1299,9 +1294,9 @@ void SavedBattleGame::prepareNewTurn()
 	// prepare a list of tiles on fire
 	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 	{
-		if (getTiles()[i]->getFire() > 0)
+		if (getTile(i)->getFire() > 0)
 		{
-			tilesOnFire.push_back(getTiles()[i]);
+			tilesOnFire.push_back(getTile(i));
 		}
 	}
 
@@ -1360,6 +1355,7 @@ void SavedBattleGame::prepareNewTurn()
 						}
 					}
 				}
+				getTileEngine()->invalidateTerrainCache((*i)->getPosition());
 				getTileEngine()->applyGravity(*i);
 			}
 		}
@@ -1368,11 +1364,11 @@ void SavedBattleGame::prepareNewTurn()
 	// prepare a list of tiles on fire/with smoke in them (smoke acts as fire intensity)
 	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 	{
-		if (getTiles()[i]->getSmoke() > 0)
+		if (getTile(i)->getSmoke() > 0)
 		{
-			tilesOnSmoke.push_back(getTiles()[i]);
+			tilesOnSmoke.push_back(getTile(i));
 		}
-		getTiles()[i]->setDangerous(false);
+		getTile(i)->setDangerous(false);
 	}
 
 	// now make the smoke spread.
@@ -1432,8 +1428,8 @@ void SavedBattleGame::prepareNewTurn()
 		// do damage to units, average out the smoke, etc.
 		for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 		{
-			if (getTiles()[i]->getSmoke() != 0)
-				getTiles()[i]->prepareNewTurn(getDepth() == 0);
+			if (getTile(i)->getSmoke() != 0)
+				getTile(i)->prepareNewTurn(getDepth() == 0);
 		}
 		// fires could have been started, stopped or smoke could reveal/conceal units.
 		getTileEngine()->calculateTerrainLighting();
@@ -1767,9 +1763,9 @@ void SavedBattleGame::resetTiles()
 {
 	for (int i = 0; i != getMapSizeXYZ(); ++i)
 	{
-		_tiles[i]->setDiscovered(false, 0);
-		_tiles[i]->setDiscovered(false, 1);
-		_tiles[i]->setDiscovered(false, 2);
+		_tiles[i].setDiscovered(false, 0);
+		_tiles[i].setDiscovered(false, 1);
+		_tiles[i].setDiscovered(false, 2);
 	}
 }
 
@@ -21,12 +21,12 @@
 #include <string>
 #include <yaml-cpp/yaml.h>
 #include "BattleUnit.h"
+#include "Tile.h"
 #include "../Mod/AlienDeployment.h"
 
 namespace OpenXcom
 {
 
-class Tile;
 class SavedGame;
 class MapDataSet;
 class Node;
@@ -50,7 +50,7 @@ private:
 	BattlescapeState *_battleState;
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
-	Tile **_tiles;
+	Tile *_tiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
 	std::vector<BattleUnit*> _units;
@@ -81,6 +81,8 @@ private:
 	bool _beforeGame;
 	/// Selects a soldier.
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
+	/// Destroys the tiles of the map.
+	void freeTiles();
 public:
 	/// Creates a new battle save, based on the current generic save.
 	SavedBattleGame();
@@ -104,8 +106,6 @@ public:
 	void setGlobalShade(int shade);
 	/// Gets the global shade.
 	int getGlobalShade() const;
-	/// Gets a pointer to the tiles, a tile is the smallest component of battlescape.
-	Tile **getTiles() const;
 	/// Gets a pointer to the list of nodes.
 	std::vector<Node*> *getNodes();
 	/// Gets a pointer to the list of items.
@@ -148,7 +148,18 @@ public:
 			|| pos.x >= _mapsize_x || pos.y >= _mapsize_y || pos.z >= _mapsize_z)
 			return 0;
 
-		return _tiles[getTileIndex(pos)];
+		return &_tiles[getTileIndex(pos)];
+	}
+
+	/**
+	 * Gets the Tile at a given index, for whole-map sweeps.
+	 * The index is not checked.
+	 * @param index Tile index, as given by getTileIndex().
+	 * @return Pointer to the tile at that index.
+	 */
+	inline Tile *getTile(int index) const
+	{
+		return &_tiles[index];
 	}
 
 	/// Gets the currently selected unit.
@@ -21,8 +21,11 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <iostream>
+#include <SDL.h>
 #include <yaml-cpp/yaml.h>
 #include "../version.h"
+#include "../lodepng.h"
 #include "../Engine/Logger.h"
 #include "../Mod/Mod.h"
 #include "../Engine/RNG.h"
@@ -30,6 +33,7 @@
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
 #include "../Engine/CrossPlatform.h"
+#include "../Engine/BinaryYaml.h"
 #include "SavedBattleGame.h"
 #include "SerializationHelper.h"
 #include "GameTime.h"
@@ -61,6 +65,246 @@ const std::string SavedGame::AUTOSAVE_GEOSCAPE = "_autogeo_.asav",
 				  SavedGame::AUTOSAVE_BATTLESCAPE = "_autobattle_.asav",
 				  SavedGame::QUICKSAVE = "_quick_.asav";
 
+namespace
+{
+
+/// Brief info of a save file, with the file state it was read from.
+struct SaveBrief
+{
+	time_t timestamp;
+	size_t size;
+	YAML::Node node;
+};
+
+/// Brief info of each save file already read.
+std::map<std::string, SaveBrief> briefCache;
+
+/// Marks the start of a binary save file.
+const char BINARY_MAGIC[4] = {'O', 'X', 'S', 'V'};
+/// Version of the binary save layout, bumped whenever it changes.
+const Uint8 BINARY_VERSION = 1;
+/// Flag for game data compressed with zlib.
+const Uint8 BINARY_COMPRESSED = 1;
+/// Magic, version, flags, brief size, data size and stored data size.
+const size_t BINARY_HEADER_SIZE = 18;
+
+void writeUint32(Uint8 *buffer, Uint32 value)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		buffer[i] = (Uint8)(value >> (i * 8));
+	}
+}
+
+Uint32 readUint32(const Uint8 *buffer)
+{
+	Uint32 value = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		value |= (Uint32)buffer[i] << (i * 8);
+	}
+	return value;
+}
+
+/**
+ * Checks if a save file header is for a binary save.
+ * YAML saves start with plain text, so they never match.
+ * @param header First bytes of the file.
+ * @param size Number of bytes.
+ * @return True for a binary save.
+ */
+bool isBinarySave(const Uint8 *header, size_t size)
+{
+	return size >= BINARY_HEADER_SIZE && std::equal(BINARY_MAGIC, BINARY_MAGIC + 4, (const char*)header);
+}
+
+/**
+ * Checks the header of a binary save.
+ * @param header Header bytes.
+ * @param path Save file path, for errors.
+ */
+void checkBinaryHeader(const Uint8 *header, const std::string &path)
+{
+	if (header[4] != BINARY_VERSION)
+	{
+		std::ostringstream ss;
+		ss << path << " is a binary save of unknown version " << (int)header[4];
+		throw Exception(ss.str());
+	}
+}
+
+/**
+ * Reads the brief info document of a save file, without
+ * reading the rest of the game data.
+ * @param path Full path to the save file.
+ * @return YAML node for the brief game info.
+ */
+YAML::Node readSaveBrief(const std::string &path)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file)
+	{
+		throw Exception(path + " not found");
+	}
+	Uint8 header[BINARY_HEADER_SIZE];
+	file.read((char*)header, BINARY_HEADER_SIZE);
+	if (!isBinarySave(header, file.gcount()))
+	{
+		file.close();
+		return YAML::LoadFile(path);
+	}
+	checkBinaryHeader(header, path);
+	std::vector<Uint8> brief(readUint32(header + 6));
+	if (!brief.empty() && !file.read((char*)&brief[0], brief.size()))
+	{
+		throw Exception(path + " is truncated");
+	}
+	BinaryYamlReader reader(brief.empty() ? 0 : &brief[0], brief.size());
+	return reader.readNode();
+}
+
+/**
+ * Reads both documents of a save file, in any save format.
+ * @param path Full path to the save file.
+ * @param brief YAML node for the brief game info.
+ * @param node YAML node for the full game data.
+ */
+void readSaveFile(const std::string &path, YAML::Node &brief, YAML::Node &node)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file)
+	{
+		throw Exception(path + " not found");
+	}
+	std::vector<Uint8> data((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
+	file.close();
+	if (!isBinarySave(data.empty() ? 0 : &data[0], data.size()))
+	{
+		std::vector<YAML::Node> docs = YAML::LoadAll(std::string(data.begin(), data.end()));
+		if (docs.size() < 2)
+		{
+			throw Exception(path + " is not a vaild save file");
+		}
+		brief = docs[0];
+		node = docs[1];
+		return;
+	}
+
+	const Uint8 *header = &data[0];
+	checkBinaryHeader(header, path);
+	size_t briefSize = readUint32(header + 6);
+	size_t dataSize = readUint32(header + 10);
+	size_t storedSize = readUint32(header + 14);
+	if (BINARY_HEADER_SIZE + briefSize + storedSize != data.size())
+	{
+		throw Exception(path + " is truncated");
+	}
+	const Uint8 *stored = header + BINARY_HEADER_SIZE + briefSize;
+
+	BinaryYamlReader briefReader(header + BINARY_HEADER_SIZE, briefSize);
+	brief = briefReader.readNode();
+	if (header[5] & BINARY_COMPRESSED)
+	{
+		std::vector<Uint8> unpacked;
+		unsigned error = lodepng::decompress(unpacked, stored, storedSize);
+		if (error || unpacked.size() != dataSize)
+		{
+			throw Exception(path + " has corrupted game data");
+		}
+		BinaryYamlReader reader(&unpacked[0], unpacked.size());
+		node = reader.readNode();
+	}
+	else
+	{
+		BinaryYamlReader reader(stored, storedSize);
+		node = reader.readNode();
+	}
+}
+
+/**
+ * Writes both documents of a save file.
+ * Doesn't touch any shared state, so it's safe to call
+ * from a worker thread.
+ * @param path Full path to the save file.
+ * @param brief YAML node for the brief game info.
+ * @param node YAML node for the full game data.
+ * @param format Save file format.
+ */
+void writeSaveFile(const std::string &path, const YAML::Node &brief, const YAML::Node &node, SaveFormat format)
+{
+	std::ofstream sav(path.c_str(), std::ios::binary);
+	if (!sav)
+	{
+		throw Exception("Failed to save " + CrossPlatform::baseFilename(path));
+	}
+	if (format == SAVE_FORMAT_YAML)
+	{
+		// emit straight into the file instead of building the whole save as a string first
+		YAML::Emitter out(sav);
+		out << brief;
+		out << YAML::BeginDoc;
+		out << node;
+	}
+	else
+	{
+		// the brief info stays uncompressed, so the saves list can read it alone
+		BinaryYamlWriter briefWriter, dataWriter;
+		briefWriter.writeNode(brief);
+		dataWriter.writeNode(node);
+		std::vector<Uint8> &briefData = briefWriter.getData();
+		std::vector<Uint8> &data = dataWriter.getData();
+		std::vector<Uint8> packed;
+		Uint8 flags = 0;
+		if (format == SAVE_FORMAT_COMPRESSED && lodepng::compress(packed, data) == 0)
+		{
+			flags |= BINARY_COMPRESSED;
+		}
+		const std::vector<Uint8> &stored = (flags & BINARY_COMPRESSED) ? packed : data;
+
+		Uint8 header[BINARY_HEADER_SIZE];
+		std::copy(BINARY_MAGIC, BINARY_MAGIC + 4, (char*)header);
+		header[4] = BINARY_VERSION;
+		header[5] = flags;
+		writeUint32(header + 6, briefData.size());
+		writeUint32(header + 10, data.size());
+		writeUint32(header + 14, stored.size());
+		sav.write((const char*)header, BINARY_HEADER_SIZE);
+		if (!briefData.empty())
+		{
+			sav.write((const char*)&briefData[0], briefData.size());
+		}
+		if (!stored.empty())
+		{
+			sav.write((const char*)&stored[0], stored.size());
+		}
+	}
+	sav.close();
+	if (!sav)
+	{
+		throw Exception("Failed to save " + CrossPlatform::baseFilename(path));
+	}
+}
+
+/**
+ * Gets the name of a save format for the save file tools.
+ * @param format Save file format.
+ * @return Format name.
+ */
+std::string getSaveFormatName(SaveFormat format)
+{
+	switch (format)
+	{
+	case SAVE_FORMAT_BINARY:
+		return "binary";
+	case SAVE_FORMAT_COMPRESSED:
+		return "compressed binary";
+	default:
+		return "YAML";
+	}
+}
+
+}
+
 struct findRuleResearch : public std::unary_function<ResearchProject *,
 								bool>
 {
@@ -249,6 +493,19 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 		}
 	}
 
+	// forget saves that have been deleted since
+	for (std::map<std::string, SaveBrief>::iterator i = briefCache.begin(); i != briefCache.end();)
+	{
+		if (!CrossPlatform::fileExists(i->first))
+		{
+			briefCache.erase(i++);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
 	return info;
 }
 
@@ -260,7 +517,21 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 {
 	std::string fullname = Options::getMasterUserFolder() + file;
-	YAML::Node doc = YAML::LoadFile(fullname);
+	time_t timestamp = CrossPlatform::getDateModified(fullname);
+	size_t size = CrossPlatform::getFileSize(fullname);
+
+	// only reparse saves that changed since the list was last shown
+	std::map<std::string, SaveBrief>::const_iterator cached = briefCache.find(fullname);
+	if (cached == briefCache.end() || cached->second.timestamp != timestamp || cached->second.size != size)
+	{
+		SaveBrief brief;
+		brief.timestamp = timestamp;
+		brief.size = size;
+		brief.node = readSaveBrief(fullname);
+		briefCache.erase(fullname);
+		cached = briefCache.insert(std::make_pair(fullname, brief)).first;
+	}
+	const YAML::Node doc = cached->second.node;
 	SaveInfo save;
 
 	save.fileName = file;
@@ -293,7 +564,7 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 		save.reserved = false;
 	}
 
-	save.timestamp = CrossPlatform::getDateModified(fullname);
+	save.timestamp = timestamp;
 	std::pair<std::string, std::string> str = CrossPlatform::timeToString(save.timestamp);
 	save.isoDate = str.first;
 	save.isoTime = str.second;
@@ -323,22 +594,29 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 }
 
 /**
- * Loads a saved game's contents from a YAML file.
+ * Drops the cached brief info of a save file, so it's
+ * read again the next time the saves are listed.
+ * Must be called from the main thread.
+ * @param file Save filename.
+ */
+void SavedGame::forgetSaveInfo(const std::string &file)
+{
+	briefCache.erase(Options::getMasterUserFolder() + file);
+}
+
+/**
+ * Loads a saved game's contents from a file in any save format.
  * @note Assumes the saved game is blank.
- * @param filename YAML filename.
+ * @param filename Save filename.
  * @param mod Mod for the saved game.
  */
 void SavedGame::load(const std::string &filename, Mod *mod)
 {
 	std::string s = Options::getMasterUserFolder() + filename;
-	std::vector<YAML::Node> file = YAML::LoadAllFromFile(s);
-	if (file.empty())
-	{
-		throw Exception(filename + " is not a vaild save file");
-	}
+	YAML::Node brief, doc;
+	readSaveFile(s, brief, doc);
 
 	// Get brief save info
-	YAML::Node brief = file[0];
 	_time->load(brief["time"]);
 	if (brief["name"])
 	{
@@ -351,7 +629,6 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 	_ironman = brief["ironman"].as<bool>(_ironman);
 
 	// Get full save data
-	YAML::Node doc = file[1];
 	_difficulty = (GameDifficulty)doc["difficulty"].as<int>(_difficulty);
 	_end = (GameEnding)doc["end"].as<int>(_end);
 	if (doc["rng"] && (_ironman || !Options::newSeedOnLoad))
@@ -497,6 +774,7 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 		if (mod->getResearch(research))
 		{
 			_discovered.push_back(mod->getResearch(research));
+			_discoveredNames.insert(research);
 		}
 		else
 		{
@@ -556,22 +834,27 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 }
 
 /**
- * Saves a saved game's contents to a YAML file.
- * @param filename YAML filename.
+ * Saves a saved game's contents to a file.
+ * @param filename Save filename.
  */
 void SavedGame::save(const std::string &filename) const
 {
-	std::string s = Options::getMasterUserFolder() + filename;
-	std::ofstream sav(s.c_str());
-	if (!sav)
-	{
-		throw Exception("Failed to save " + filename);
-	}
-
-	YAML::Emitter out;
+	YAML::Node brief, node;
+	save(brief, node);
+	write(filename, brief, node);
+	forgetSaveInfo(filename);
+}
 
+/**
+ * Saves a saved game's contents to YAML documents, without
+ * writing them out yet. The documents don't reference the
+ * game anymore, so they can be written on another thread.
+ * @param brief YAML node for the brief game info.
+ * @param node YAML node for the full game data.
+ */
+void SavedGame::save(YAML::Node &brief, YAML::Node &node) const
+{
 	// Saves the brief game info used in the saves list
-	YAML::Node brief;
 	brief["name"] = _name;
 	brief["version"] = OPENXCOM_VERSION_SHORT;
 	std::string git_sha = OPENXCOM_VERSION_GIT;
@@ -597,10 +880,7 @@ void SavedGame::save(const std::string &filename) const
 	brief["mods"] = modsList;
 	if (_ironman)
 		brief["ironman"] = _ironman;
-	out << brief;
 	// Saves the full game data to the save
-	out << YAML::BeginDoc;
-	YAML::Node node;
 	node["difficulty"] = (int)_difficulty;
 	node["end"] = (int)_end;
 	node["monthsPassed"] = _monthsPassed;
@@ -661,6 +941,11 @@ void SavedGame::save(const std::string &filename) const
 	{
 		node["poppedResearch"].push_back((*i)->getName());
 	}
+	// plain lists that keep growing are written inline to keep saves compact
+	if (!_discovered.empty())
+		node["discovered"].SetStyle(YAML::EmitterStyle::Flow);
+	if (!_poppedResearch.empty())
+		node["poppedResearch"].SetStyle(YAML::EmitterStyle::Flow);
 	node["alienStrategy"] = _alienStrategy->save();
 	for (std::vector<Soldier*>::const_iterator i = _deadSoldiers.begin(); i != _deadSoldiers.end(); ++i)
 	{
@@ -677,13 +962,111 @@ void SavedGame::save(const std::string &filename) const
 	{
 		node["battleGame"] = _battleGame->save();
 	}
-	out << node;
-	sav << out.c_str();
-	sav.close();
-	if (!sav)
+}
+
+/**
+ * Writes the YAML documents of a saved game to a file,
+ * in the save format picked in the options.
+ * Doesn't touch any shared state, so it's safe to call
+ * from a worker thread.
+ * @param filename Save filename.
+ * @param brief YAML node for the brief game info.
+ * @param node YAML node for the full game data.
+ */
+void SavedGame::write(const std::string &filename, const YAML::Node &brief, const YAML::Node &node)
+{
+	writeSaveFile(Options::getMasterUserFolder() + filename, brief, node, Options::saveFormat);
+}
+
+/**
+ * Rewrites a save file in the save format picked in the
+ * options, so saves can be turned into YAML for editing
+ * and debugging, and back.
+ * @param path Path to the save file.
+ * @return True if the save was converted.
+ */
+bool SavedGame::convertFile(const std::string &path)
+{
+	try
+	{
+		YAML::Node brief, node;
+		readSaveFile(path, brief, node);
+		// same as saving in game, don't lose the original if the write fails
+		std::string backup = path + ".bak";
+		writeSaveFile(backup, brief, node, Options::saveFormat);
+		if (!CrossPlatform::moveFile(backup, path))
+		{
+			throw Exception("Converted save left in " + backup);
+		}
+	}
+	catch (Exception &e)
+	{
+		std::cerr << path << ": " << e.what() << std::endl;
+		return false;
+	}
+	catch (YAML::Exception &e)
 	{
-		throw Exception("Failed to save " + filename);
+		std::cerr << path << ": " << e.what() << std::endl;
+		return false;
 	}
+	std::cout << "Converted " << path << " to " << getSaveFormatName(Options::saveFormat) << std::endl;
+	return true;
+}
+
+/**
+ * Times writing and reading the documents of a save
+ * file in every save format, and reports the file sizes.
+ * Building the game objects from the documents is the
+ * same for every format, so it isn't timed.
+ * @param path Path to the save file.
+ * @return True if the benchmark ran to the end.
+ */
+bool SavedGame::benchmarkFile(const std::string &path)
+{
+	const int runs = 3;
+	std::string temp = path + ".bench";
+	bool ok = true;
+	SDL_InitSubSystem(SDL_INIT_TIMER);
+	try
+	{
+		YAML::Node brief, node;
+		readSaveFile(path, brief, node);
+		std::cout << "Save file: " << path << " (" << runs << " runs each)" << std::endl;
+		const SaveFormat formats[] = { SAVE_FORMAT_YAML, SAVE_FORMAT_BINARY, SAVE_FORMAT_COMPRESSED };
+		for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i)
+		{
+			Uint32 startTime = SDL_GetTicks();
+			for (int run = 0; run < runs; ++run)
+			{
+				writeSaveFile(temp, brief, node, formats[i]);
+			}
+			Uint32 writeTime = (SDL_GetTicks() - startTime) / runs;
+
+			startTime = SDL_GetTicks();
+			for (int run = 0; run < runs; ++run)
+			{
+				YAML::Node runBrief, runNode;
+				readSaveFile(temp, runBrief, runNode);
+			}
+			Uint32 readTime = (SDL_GetTicks() - startTime) / runs;
+
+			std::cout << getSaveFormatName(formats[i]) << ": " << CrossPlatform::getFileSize(temp) << " bytes, "
+				<< "written in " << writeTime << " ms, read in " << readTime << " ms" << std::endl;
+		}
+	}
+	catch (Exception &e)
+	{
+		std::cerr << path << ": " << e.what() << std::endl;
+		ok = false;
+	}
+	catch (YAML::Exception &e)
+	{
+		std::cerr << path << ": " << e.what() << std::endl;
+		ok = false;
+	}
+	CrossPlatform::deleteFile(temp);
+	SDL_QuitSubSystem(SDL_INIT_TIMER);
+	return ok;
 }
 
 /**
@@ -1084,6 +1467,7 @@ void SavedGame::setBattleGame(SavedBattleGame *battleGame)
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
 {
 	_discovered.push_back(research);
+	_discoveredNames.insert(research->getName());
 }
 
 /**
@@ -1112,6 +1496,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		if (!isResearched(currentQueueItem->getName(), false))
 		{
 			_discovered.push_back(currentQueueItem);
+			_discoveredNames.insert(currentQueueItem->getName());
 			if (!hasUndiscoveredProtectedUnlocks && isResearched(currentQueueItem->getGetOneFree(), false))
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
@@ -1220,12 +1605,14 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> & proje
 {
 	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
 	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
+	std::set<std::string> unlocked;
 	for (std::vector<const RuleResearch *>::const_iterator it = _discovered.begin(); it != _discovered.end(); ++it)
 	{
 		for (std::vector<std::string>::const_iterator itUnlocked = (*it)->getUnlocked().begin(); itUnlocked != (*it)->getUnlocked().end(); ++itUnlocked)
 		{
-			unlocked.push_back(mod->getResearch(*itUnlocked, true));
+			// still reports unknown topics
+			mod->getResearch(*itUnlocked, true);
+			unlocked.insert(*itUnlocked);
 		}
 	}
 
@@ -1234,7 +1621,7 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> & proje
 	{
 		RuleResearch *research = mod->getResearch(*iter);
 
-		if ((considerDebugMode && _debug) || std::find(unlocked.begin(), unlocked.end(), research) != unlocked.end())
+		if ((considerDebugMode && _debug) || unlocked.find(*iter) != unlocked.end())
 		{
 			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
 		}
@@ -1412,13 +1799,7 @@ bool SavedGame::isResearched(const std::string &research, bool considerDebugMode
 	//	return true;
 	if (considerDebugMode && _debug)
 		return true;
-	for (std::vector<const RuleResearch *>::const_iterator i = _discovered.begin(); i != _discovered.end(); ++i)
-	{
-		if ((*i)->getName() == research)
-			return true;
-	}
-
-	return false;
+	return _discoveredNames.find(research) != _discoveredNames.end();
 }
 
 /**
@@ -1433,22 +1814,13 @@ bool SavedGame::isResearched(const std::vector<std::string> &research, bool cons
 		return true;
 	if (considerDebugMode && _debug)
 		return true;
-	std::vector<std::string> matches = research;
-	for (std::vector<const RuleResearch *>::const_iterator i = _discovered.begin(); i != _discovered.end(); ++i)
+	for (std::vector<std::string>::const_iterator i = research.begin(); i != research.end(); ++i)
 	{
-		for (std::vector<std::string>::iterator j = matches.begin(); j != matches.end(); ++j)
-		{
-			if ((*i)->getName() == *j)
-			{
-				j = matches.erase(j);
-				break;
-			}
-		}
-		if (matches.empty())
-			return true;
+		if (_discoveredNames.find(*i) == _discoveredNames.end())
+			return false;
 	}
 
-	return false;
+	return true;
 }
 
 /**
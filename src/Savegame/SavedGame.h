@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <time.h>
@@ -119,6 +120,7 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	std::set<std::string> _discoveredNames;
 	std::vector<AlienMission*> _activeMissions;
 	bool _debug, _warned;
 	int _monthsPassed;
@@ -142,10 +144,20 @@ public:
 	static std::string sanitizeModName(const std::string &name);
 	/// Gets list of saves in the user directory.
 	static std::vector<SaveInfo> getList(Language *lang, bool autoquick);
-	/// Loads a saved game from YAML.
+	/// Forgets the cached info of a save file.
+	static void forgetSaveInfo(const std::string &file);
+	/// Loads a saved game from a file.
 	void load(const std::string &filename, Mod *mod);
 	/// Saves a saved game to YAML.
 	void save(const std::string &filename) const;
+	/// Saves a saved game to YAML documents.
+	void save(YAML::Node &brief, YAML::Node &node) const;
+	/// Writes saved game YAML documents to a file.
+	static void write(const std::string &filename, const YAML::Node &brief, const YAML::Node &node);
+	/// Rewrites a save file in the current save format.
+	static bool convertFile(const std::string &path);
+	/// Times reading and writing a save file in every save format.
+	static bool benchmarkFile(const std::string &path);
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -130,7 +130,11 @@ YAML::Node SoldierDiary::save() const
 			node["commendations"].push_back((*i)->save());
 	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
 			node["killList"].push_back((*i)->save());
-	if (!_missionIdList.empty()) node["missionIdList"] = _missionIdList;
+	if (!_missionIdList.empty())
+	{
+		node["missionIdList"] = _missionIdList;
+		node["missionIdList"].SetStyle(YAML::EmitterStyle::Flow);
+	}
 	if (_daysWoundedTotal) node["daysWoundedTotal"] = _daysWoundedTotal;
 	if (_totalShotByFriendlyCounter) node["totalShotByFriendlyCounter"] = _totalShotByFriendlyCounter;
 	if (_totalShotFriendlyCounter) node["totalShotFriendlyCounter"] = _totalShotFriendlyCounter;
@@ -49,7 +49,7 @@ Tile::SerializationKey Tile::serializationKey =
  * constructor
  * @param pos Position.
  */
-Tile::Tile(Position pos): _smoke(0), _fire(0), _explosive(0), _explosiveType(0), _pos(pos), _unit(0), _animationOffset(0), _markerColor(0), _visible(false), _preview(-1), _TUMarker(-1), _overlaps(0), _danger(false), _obstacle(0)
+Tile::Tile(Position pos): _danger(false), _smoke(0), _fire(0), _explosive(0), _explosiveType(0), _pos(pos), _unit(0), _animationOffset(0), _markerColor(0), _visible(false), _preview(-1), _TUMarker(-1), _overlaps(0), _obstacle(0)
 {
 	for (int i = 0; i < 4; ++i)
 	{
@@ -61,7 +61,6 @@ Tile::Tile(Position pos): _smoke(0), _fire(0), _explosive(0), _explosiveType(0),
 	for (int layer = 0; layer < LIGHTLAYERS; layer++)
 	{
 		_light[layer] = 0;
-		_lastLight[layer] = -1;
 	}
 	for (int i = 0; i < 3; ++i)
 	{
@@ -421,7 +420,6 @@ bool Tile::isDiscovered(int part) const
 void Tile::resetLight(int layer)
 {
 	_light[layer] = 0;
-	_lastLight[layer] = _light[layer];
 }
 
 /**
@@ -61,9 +61,10 @@ protected:
 	MapData *_objects[4];
 	int _mapDataID[4];
 	int _mapDataSetID[4];
-	int _currentFrame[4];
+	Uint8 _currentFrame[4];
 	bool _discovered[3];
-	int _light[LIGHTLAYERS], _lastLight[LIGHTLAYERS];
+	bool _danger;
+	int _light[LIGHTLAYERS];
 	int _smoke;
 	int _fire;
 	int _explosive;
@@ -77,7 +78,6 @@ protected:
 	int _preview;
 	int _TUMarker;
 	int _overlaps;
-	bool _danger;
 	std::list<Particle*> _particles;
 	int _obstacle;
 public:
@@ -145,6 +145,17 @@ public:
 		return (_objects[part] && _objects[part]->isUFODoor() && _currentFrame[part] != 0);
 	}
 
+	/**
+	 * Check if the ufo door has only just started opening, so its TU cost is about to change.
+	 * @param part Tile part to look for door
+	 * @return bool
+	 */
+	bool isUfoDoorOpening(TilePart tp) const
+	{
+		int part = (int)tp;
+		return (_objects[part] && _objects[part]->isUFODoor() && _currentFrame[part] == 1);
+	}
+
 	/// Close ufo door.
 	int closeUfoDoor();
 	/// Sets the black fog of war status of this tile.
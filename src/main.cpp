@@ -23,6 +23,8 @@
 #include "Engine/Game.h"
 #include "Engine/Options.h"
 #include "Menu/StartState.h"
+#include "Geoscape/GeoscapeSimulation.h"
+#include "Savegame/SavedGame.h"
 
 /** @mainpage
  * @author OpenXcom Developers
@@ -108,15 +110,34 @@ int main(int argc, char *argv[])
 #endif
 	if (!Options::init(argc, argv))
 		return EXIT_SUCCESS;
+	// save file tools don't need the game running
+	if (Options::getSaveTool() == "convertsave")
+		return SavedGame::convertFile(Options::getSaveToolFile()) ? EXIT_SUCCESS : EXIT_FAILURE;
+	if (Options::getSaveTool() == "benchsave")
+		return SavedGame::benchmarkFile(Options::getSaveToolFile()) ? EXIT_SUCCESS : EXIT_FAILURE;
 	std::ostringstream title;
 	title << "OpenXcom " << OPENXCOM_VERSION_SHORT << OPENXCOM_VERSION_GIT;
 	if (Options::verboseLogging)
 		Logger::reportingLevel() = LOG_VERBOSE;
 	Options::baseXResolution = Options::displayWidth;
 	Options::baseYResolution = Options::displayHeight;
+	// simulations run with no window or sound
+	bool simulate = Options::getSimulateMonths() != 0;
+	if (simulate)
+	{
+		SDL_putenv(const_cast<char*>("SDL_VIDEODRIVER=dummy"));
+		SDL_putenv(const_cast<char*>("SDL_AUDIODRIVER=dummy"));
+		Options::useOpenGL = false;
+	}
 
 	game = new Game(title.str());
 	State::setGamePtr(game);
+	if (simulate)
+	{
+		bool ok = GeoscapeSimulation::runBatch(game);
+		delete game;
+		return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
 	game->setState(new StartState);
 	game->run();
 